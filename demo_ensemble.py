@@ -0,0 +1,49 @@
+import numpy as np
+from _schon import BipartiteNetwork, ContinuousSIS, Ensemble
+
+#structure : all individuals belong to two groups
+N = 500
+edge_list = []
+for node in range(N):
+    edge_list.append((node,0))
+    edge_list.append((node,1))
+
+#the network is built once and shared by all replicas
+network = BipartiteNetwork(edge_list)
+
+#infection parameter
+recovery_rate = 1.
+group_transmission_rate = [0.5*10**(-3),1.2*10**(-3)]
+infection_rate = np.zeros((N+1,N+1))
+for n in range(2,N+1):
+    for i in range(n+1):
+        infection_rate[n][i] = i
+initial_infected_fraction = 0.05
+seed = 42
+nb_history = 50
+
+#each replica uses its own stream of the RNG
+def factory(replica):
+    cont = ContinuousSIS(network,recovery_rate,infection_rate,
+                         group_transmission_rate)
+    cont.seed(seed,replica)
+    cont.infect_fraction(initial_infected_fraction)
+    cont.initialize_history(nb_history)
+    cont.measure_prevalence()
+    cont.measure_marginal_infection_probability()
+    return cont
+
+#evolve 100 replicas on all available threads: burn-in without measuring,
+#then evolve and measure in the quasistationary state
+nb_replicas = 100
+ensemble = Ensemble(factory,nb_replicas)
+ensemble.run(100,1000,decorrelation_time=1,quasistationary=True)
+
+#print the result measure, merged over replicas
+for measure in ensemble.get_measure_vector():
+    name = measure.get_name()
+    if name == "prevalence":
+        print("----------------")
+        print(name)
+        print("----------------")
+        print(np.mean(measure.get_result()))
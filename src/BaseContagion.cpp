@@ -25,61 +25,119 @@
 #include "BaseContagion.hpp"
 #include <optional>
 #include <utility>
+#include <memory>
 #include <iostream>
 #include <exception>
+#include <stdexcept>
+#include <random>
+#include <numeric>
+#include <algorithm>
 
 using namespace std;
 
 namespace schon
 {//start of namespace schon
 
-//constructor of the class
+//a configuration is loaded in bulk when more than N/BULK_LOAD_FACTOR nodes
+//change state
+const size_t BULK_LOAD_FACTOR = 16;
+
+//constructor of the class from an edge list
 BaseContagion::BaseContagion(const EdgeList& edge_list):
-    network_(edge_list),
-    node_state_vector_(network_.size(), S),
-    group_state_vector_(network_.number_of_groups()),
-    group_state_position_vector_(network_.number_of_groups()),
+    BaseContagion(make_shared<const BipartiteNetwork>(edge_list))
+{
+}
+
+//constructor of the class from a shared network
+BaseContagion::BaseContagion(SharedNetwork network):
+    network_(checked_network(network)),
+    node_state_vector_(network_->size(), S),
+    group_state_vector_(network_->number_of_groups()),
+    group_member_vector_(network_->number_of_edges()),
+    membership_position_vector_(network_->number_of_edges()),
     infected_node_set_(),
-    history_vector_(),
+    number_of_recovered_nodes_(0),
+    history_(),
     current_time_(0),
     last_event_time_(0),
     time_since_last_measure_(0),
-    gen_(sset::BaseSamplableSet::gen_),
+    gen_(pcg_extras::seed_seq_from<std::random_device>()),
     random_01_()
 {
-    //initialize group state vector and position
-    for (Group group : network_.groups())
+    //initialize group state vector and position, all nodes are S
+    for (Group group : network_->groups())
     {
-        for (unsigned int state = S; state < STATECOUNT; state++)
-        {
-            group_state_vector_[group].push_back(vector<Node>());
-        }
-        for (Node node : network_.group_members(group))
-        {
-            group_state_position_vector_[group][node] =
-                group_state_vector_[group][0].size();
-            group_state_vector_[group][0].push_back(node); //nodes are S
-        }
+        group_state_vector_[group].fill(0);
+        group_state_vector_[group][S] = network_->group_size(group);
+    }
+    iota(group_member_vector_.begin(), group_member_vector_.end(), 0);
+    iota(membership_position_vector_.begin(),
+            membership_position_vector_.end(), 0);
+}
+
+//return the network, after making sure that there is one to dereference
+const SharedNetwork& BaseContagion::checked_network(
+        const SharedNetwork& network)
+{
+    if (not network)
+    {
+        throw invalid_argument("Contagion: the network is null");
     }
+    return network;
 }
 
 //get a random node of the particular state in the group
 Node BaseContagion::random_node(Group group, NodeState node_state) const
 {
-    const GroupState& group_state = group_state_vector_[group];
-    unsigned int index = floor(random_01_(gen_)*group_state[node_state].size());
-    return group_state[node_state][index];
+    Span<Membership> members = group_state_members(group, node_state);
+    unsigned int index = floor(random_01_(gen_)*members.size());
+    return network_->member(members[index]);
 }
 
 //infect a fraction of the nodes
 void BaseContagion::infect_fraction(double fraction)
 {
-    unsigned int number_of_infection = floor(network_.size()*fraction);
+    unsigned int number_of_infection = floor(network_->size()*fraction);
+    //the bulk load is only valid if no node is in another state
+    if (number_of_infection*BULK_LOAD_FACTOR > network_->size()
+            and only_susceptible_or_infected())
+    {
+        vector<Node> node_vector;
+        if (infected_node_set_.empty())
+        {
+            node_vector = sample_nodes(number_of_infection);
+        }
+        else
+        {
+            for (Node node = 0; node < network_->size(); node++)
+            {
+                if (node_state_vector_[node] == S)
+                {
+                    node_vector.push_back(node);
+                }
+            }
+            //partial Fisher-Yates shuffle of the susceptible nodes
+            size_t number_of_susceptible = node_vector.size();
+            number_of_infection = min(number_of_infection,
+                    (unsigned int) number_of_susceptible);
+            for (size_t i = 0; i < number_of_infection; i++)
+            {
+                size_t j = i + floor(random_01_(gen_)
+                        *(number_of_susceptible - i));
+                swap(node_vector[i], node_vector[j]);
+            }
+            node_vector.resize(number_of_infection);
+        }
+        node_vector.insert(node_vector.end(), infected_node_set_.begin(),
+                infected_node_set_.end());
+        load_configuration(node_vector);
+        return;
+    }
     Node node;
     unsigned int count = 0;
     while (count < number_of_infection)
     {
-        node = floor(random_01_(gen_)*network_.size());
+        node = floor(random_01_(gen_)*network_->size());
         if (node_state_vector_[node] == S)
         {
             infect(node);
@@ -88,9 +146,60 @@ void BaseContagion::infect_fraction(double fraction)
     }
 }
 
+//sample distinct nodes uniformly without scanning the states; when most
+//nodes are sampled, the complement is drawn instead, so that the rejection
+//of repeated nodes stays rare
+vector<Node> BaseContagion::sample_nodes(size_t number_of_nodes)
+{
+    size_t size = network_->size();
+    number_of_nodes = min(number_of_nodes, size);
+    bool complement = 2*number_of_nodes > size;
+    size_t number_of_draws = complement ? size - number_of_nodes
+        : number_of_nodes;
+    vector<bool> drawn(size, false);
+    vector<Node> node_vector;
+    node_vector.reserve(number_of_nodes);
+    size_t count = 0;
+    while (count < number_of_draws)
+    {
+        Node node = floor(random_01_(gen_)*size);
+        if (not drawn[node])
+        {
+            drawn[node] = true;
+            count++;
+            if (not complement)
+            {
+                node_vector.push_back(node);
+            }
+        }
+    }
+    if (complement)
+    {
+        for (Node node = 0; node < size; node++)
+        {
+            if (not drawn[node])
+            {
+                node_vector.push_back(node);
+            }
+        }
+    }
+    return node_vector;
+}
+
 //infect a certain set of of nodes
 void BaseContagion::infect_node_set(const std::unordered_set<Node>& node_set)
 {
+    //the bulk load is only valid if no node is in another state
+    if (node_set.size()*BULK_LOAD_FACTOR > network_->size()
+            and only_susceptible_or_infected())
+    {
+        vector<Node> node_vector(infected_node_set_.begin(),
+                infected_node_set_.end());
+        node_vector.insert(node_vector.end(), node_set.begin(),
+                node_set.end());
+        load_configuration(node_vector);
+        return;
+    }
     for (Node node : node_set)
     {
         if (node_state_vector_[node] == S)
@@ -104,10 +213,10 @@ void BaseContagion::infect_node_set(const std::unordered_set<Node>& node_set)
 //clear the state; as if all node became susceptible at this time
 void BaseContagion::clear()
 {
-    //recover nodes
-    for (Node node : infected_node_set_)
+    //recover nodes, each recovery erasing the node from the set
+    while (not infected_node_set_.empty())
     {
-        recover(node);
+        recover(*infected_node_set_.begin());
     }
 }
 
@@ -121,96 +230,122 @@ void BaseContagion::reset()
     {
         measure_vector_[i] -> clear();
     }
-    history_vector_.clear();
+    history_.clear();
     current_time_ = 0;
     last_event_time_ = 0;
     time_since_last_measure_ = 0;
 }
 
+//fill the history with the current configuration, which must be non trivial
 void BaseContagion::initialize_history(std::size_t number_of_states)
 {
-    if (history_vector_.size() > 0)
-    {
-        history_vector_.clear();
-    }
-    //must be non trivial
-    history_vector_ = std::vector<std::unordered_set<Node>>(number_of_states,
-            infected_node_set_);
+    history_.assign(number_of_states, node_state_vector_, infected_node_set_);
 }
 
+//replace a random configuration of the history by the current one
 void BaseContagion::store_configuration()
 {
-    //delete randomly one configuration before
-    size_t index = floor(random_01_(gen_)*history_vector_.size());
-    swap(history_vector_[index], history_vector_.back());
-    history_vector_.pop_back();
-    history_vector_.push_back(infected_node_set_);
+    size_t index = floor(random_01_(gen_)*history_.size());
+    history_.replace(index, node_state_vector_, infected_node_set_);
 }
 
+//restore a random configuration of the history; when few nodes change
+//state, only those are recovered or infected, otherwise the configuration
+//is loaded in bulk, if this leads to the same state
 void BaseContagion::get_configuration_from_history()
 {
-    clear();
-    size_t index = floor(random_01_(gen_)*history_vector_.size());
-    const std::unordered_set<Node>& infected_node_set = history_vector_[index];
-    for (Node node : infected_node_set)
+    size_t index = floor(random_01_(gen_)*history_.size());
+    Span<Node> configuration = history_[index];
+    vector<Node> recovered_node_vector;
+    for (Node node : infected_node_set_)
+    {
+        if (not binary_search(configuration.begin(), configuration.end(),
+                    node))
+        {
+            recovered_node_vector.push_back(node);
+        }
+    }
+    size_t number_of_changes = recovered_node_vector.size()
+        + configuration.size() - (infected_node_set_.size()
+                - recovered_node_vector.size());
+    if (number_of_changes*BULK_LOAD_FACTOR > network_->size()
+            and recovers_to_susceptible() and only_susceptible_or_infected())
+    {
+        load_configuration(configuration);
+        return;
+    }
+    for (Node node : recovered_node_vector)
     {
-        infect(node);
+        recover(node);
+    }
+    for (Node node : configuration)
+    {
+        if (node_state_vector_[node] != I)
+        {
+            infect(node);
+        }
     }
 }
 
-//perform the evolution of the process over a period of time and perform
-//measures after each decorrelation time if needed
-void BaseContagion::evolve(double period, double decorrelation_time, bool measure,
-        bool quasistationary)
+//set the given nodes infected (repeats allowed) and all others susceptible,
+//then rebuild the state segments of the groups and the events in one pass;
+//the nodes in other states would be lost, so there must be none
+void BaseContagion::load_configuration(Span<Node> infected_nodes)
 {
-    if (quasistationary and history_vector_.size() == 0)
-    {
-        initialize_history();
-    }
-    double initial_time = current_time_;
-    while(last_event_time_ + get_lifetime() - initial_time < period)
+    for (Node node : infected_nodes)
     {
-        time_since_last_measure_ += last_event_time_
-            + get_lifetime() - current_time_; //after the coming event
-        if (time_since_last_measure_ > decorrelation_time)
+        if (node >= network_->size())
         {
-            time_since_last_measure_ -= decorrelation_time;
-            if (measure)
-            {
-                for(size_t i = 0; i < measure_vector_.size(); i++)
-                {
-                    measure_vector_[i] -> measure(this);
-                }
-            }
-            if (quasistationary)
-            {
-                store_configuration();
-            }
+            throw out_of_range("Configuration: the node does not exist");
         }
-        next_event();
-        if (isinf(get_lifetime()) and quasistationary)
+    }
+    if (not only_susceptible_or_infected())
+    {
+        throw runtime_error("Configuration: some nodes are neither "
+                "susceptible nor infected");
+    }
+    fill(node_state_vector_.begin(), node_state_vector_.end(), S);
+    for (Node node : infected_nodes)
+    {
+        node_state_vector_[node] = I;
+    }
+    //the set is filled in the order of the nodes, so that its buckets are
+    //visited in sequence
+    infected_node_set_.clear();
+    infected_node_set_.reserve(infected_nodes.size());
+    for (Node node = 0; node < network_->size(); node++)
+    {
+        if (node_state_vector_[node] == I)
         {
-            get_configuration_from_history();
+            infected_node_set_.insert(node);
         }
     }
-    time_since_last_measure_ += period - (last_event_time_ - initial_time);
-    //if we need to perform a last measure
-    if (time_since_last_measure_ > decorrelation_time)
+    //place the members of each group in the segment of their state
+    for (Group group : network_->groups())
     {
-        time_since_last_measure_ -= decorrelation_time;
-        if (measure)
+        GroupState& group_state = group_state_vector_[group];
+        Membership first = network_->first_membership(group);
+        Membership last = first + network_->group_size(group);
+        group_state.fill(0);
+        for (Membership membership = first; membership < last; membership++)
         {
-            for(size_t i = 0; i < measure_vector_.size(); i++)
-            {
-                measure_vector_[i] -> measure(this);
-            }
+            group_state[node_state_vector_[network_->member(membership)]]++;
+        }
+        array<Membership,STATECOUNT> position; //next of each segment
+        position[S] = first;
+        for (unsigned int state = S+1; state < STATECOUNT; state++)
+        {
+            position[state] = position[state-1] + group_state[state-1];
         }
-        if (quasistationary)
+        for (Membership membership = first; membership < last; membership++)
         {
-            store_configuration();
+            NodeState node_state =
+                node_state_vector_[network_->member(membership)];
+            group_member_vector_[position[node_state]] = membership;
+            membership_position_vector_[membership] = position[node_state]++;
         }
     }
-    current_time_ = initial_time + period;
+    rebuild_event_set();
 }
 
 
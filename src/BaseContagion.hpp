@@ -26,8 +26,10 @@
 #define BASECONTAGION_HPP_
 
 #include "MeasurableContagionProcess.hpp"
+#include "ConfigurationHistory.hpp"
 #include "SamplableSet/SamplableSet.hpp"
 #include <iostream>
+#include <cmath>
 
 namespace schon
 {//start of namespace schon
@@ -39,66 +41,145 @@ class BaseContagion : public MeasurableContagionProcess
 public:
     //Constructor
     BaseContagion(const EdgeList& edge_list);
+    BaseContagion(SharedNetwork network);
 
     //Accessors
     std::size_t size() const
-        {return network_.size();}
+        {return network_->size();}
     const std::vector<NodeState>& get_node_state_vector() const
         {return node_state_vector_;}
     const std::unordered_set<Node>& get_infected_node_set() const
         {return infected_node_set_;}
     const BipartiteNetwork& get_network() const
+        {return *network_;}
+    SharedNetwork get_shared_network() const
         {return network_;}
     double get_current_time() const
         {return current_time_;}
     std::size_t get_number_of_infected_nodes() const
         {return infected_node_set_.size();}
-    double get_lifetime() const //dummy definition
-        {return 1;}
 
     //Mutators
     void seed(unsigned int seed)
         {gen_.seed(seed);}
+    void seed(unsigned int seed, unsigned long long stream)
+        {gen_.seed(seed, stream);}
     void infect_fraction(double fraction);
     void infect_node_set(const std::unordered_set<Node>& node_set);
+    void load_configuration(const std::vector<Node>& infected_node_vector)
+        {load_configuration(Span<Node>(infected_node_vector.data(),
+                    infected_node_vector.data()
+                    + infected_node_vector.size()));}
 
     void clear();
     void reset();
     void initialize_history(std::size_t number_of_states = 100);
 
-    void evolve(double period, double decorrelation_time=1, bool measure=false,
-            bool quasistationary=false);
-
-
-    //it seems abstract base class definition in the binding does not work
+    //each process implements the evolution loop with its own events, see
+    //ContagionEngine
+    virtual void evolve(double period, double decorrelation_time=1,
+            bool measure=false, bool quasistationary=false) = 0;
 
 protected:
     //Members
-    BipartiteNetwork network_;
+    SharedNetwork network_;
     std::vector<NodeState> node_state_vector_;
     std::vector<GroupState> group_state_vector_;
-    std::vector<GroupStatePosition> group_state_position_vector_;
+    std::vector<Membership> group_member_vector_; //S, I, R segments by group
+    std::vector<Membership> membership_position_vector_; //in member vector
     std::unordered_set<Node> infected_node_set_;
-    std::vector<std::unordered_set<Node>> history_vector_;
+    std::size_t number_of_recovered_nodes_; //in state R, never S again
+    ConfigurationHistory history_;
 
     double current_time_;
     double last_event_time_;
     double time_since_last_measure_;
-    sset::RNGType &gen_;
+    mutable sset::RNGType gen_; //own stream, shared with owned samplers
     mutable std::uniform_real_distribution<double> random_01_;
 
     //utility functions
+    static const SharedNetwork& checked_network(const SharedNetwork& network);
+    Event recovery_event(Node node) const
+        {return node;}
+    Event infection_event(Group group) const
+        {return network_->size() + group;}
+    bool is_recovery_event(Event event) const
+        {return event < network_->size();}
+    Group event_group(Event event) const
+        {return event - network_->size();}
+    Span<Membership> group_state_members(Group group,
+            NodeState node_state) const;
     Node random_node(Group group, NodeState node_state) const;
+    std::vector<Node> sample_nodes(std::size_t number_of_nodes);
+    inline void update_group_state(Group group, Membership membership,
+            NodeState previous_state, NodeState new_state);
     void store_configuration();
     void get_configuration_from_history();
-
-    void infect(Node node) {}; //dummy definition
-    void recover(Node node) {}; //dummy definition
-    void next_event() {}; //dummy definition
-
-
+    void load_configuration(Span<Node> infected_nodes);
+    //recompute all the events from the state of the nodes and groups, after
+    //a bulk change of the configuration; the infected nodes are read from
+    //the node states, in order, rather than from the set
+    virtual void rebuild_event_set() = 0;
+    //whether a recovered node becomes susceptible, as the nodes that are not
+    //infected in a loaded configuration
+    virtual bool recovers_to_susceptible() const
+        {return true;}
+    bool only_susceptible_or_infected() const
+        {return number_of_recovered_nodes_ == 0;}
 };
 
+//get the members of the group in a given state, a contiguous segment
+inline Span<Membership> BaseContagion::group_state_members(Group group,
+        NodeState node_state) const
+{
+    const GroupState& group_state = group_state_vector_[group];
+    const Membership* first = group_member_vector_.data()
+        + network_->first_membership(group);
+    for (unsigned int state = S; state < node_state; state++)
+    {
+        first += group_state[state];
+    }
+    return Span<Membership>(first, first + group_state[node_state]);
+}
+
+//move a membership from a state segment of the group to another; each step
+//swaps it with the member at the edge of its segment, then moves the boundary
+inline void BaseContagion::update_group_state(Group group,
+        Membership membership, NodeState previous_state, NodeState new_state)
+{
+    GroupState & group_state = group_state_vector_[group];
+    Membership start = network_->first_membership(group); //of current segment
+    for (unsigned int state = S; state < previous_state; state++)
+    {
+        start += group_state[state];
+    }
+    unsigned int state = previous_state;
+    while (state != new_state)
+    {
+        Membership boundary;
+        if (state < new_state)
+        {
+            boundary = start + group_state[state] - 1; //last of the segment
+            group_state[state]--;
+            group_state[++state]++;
+            start = boundary;
+        }
+        else
+        {
+            boundary = start; //first of the segment
+            group_state[state]--;
+            group_state[--state]++;
+            start = boundary + 1 - group_state[state];
+        }
+        Membership position = membership_position_vector_[membership];
+        Membership displaced = group_member_vector_[boundary];
+        group_member_vector_[position] = displaced;
+        membership_position_vector_[displaced] = position;
+        group_member_vector_[boundary] = membership;
+        membership_position_vector_[membership] = boundary;
+    }
+}
+
 }//end of namespace schon
 
 #endif /* BASECONTAGION_HPP_ */
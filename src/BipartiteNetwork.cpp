@@ -24,6 +24,8 @@
 
 #include "BipartiteNetwork.hpp"
 #include <numeric>
+#include <limits>
+#include <stdexcept>
 
 using namespace std;
 
@@ -32,39 +34,89 @@ namespace schon
 
 //Constructor of the class provided an edge list
 BipartiteNetwork::BipartiteNetwork(const EdgeList& edge_list) :
-	node_adjacency_list_(), group_adjacency_list_(), nodes_(), groups_(),
-    min_membership_(0), max_membership_(0), min_group_size_(0),
-    max_group_size_(0)
+	node_offset_(), node_adjacency_(), group_offset_(), group_adjacency_(),
+    node_membership_(), nodes_(), groups_(), min_membership_(0),
+    max_membership_(0), min_group_size_(0), max_group_size_(0)
 {
+    build(edge_list.size(), [&edge_list](size_t i)
+            {return edge_list[i];});
+}
+
+//Constructor of the class provided arrays of nodes and groups, the i-th edge
+//being (node_array[i*stride], group_array[i*stride]); for instance, an edge
+//array of shape (E,2) is read with group_array = node_array + 1, stride = 2
+BipartiteNetwork::BipartiteNetwork(const Node* node_array,
+        const Group* group_array, size_t number_of_edges, size_t stride) :
+	node_offset_(), node_adjacency_(), group_offset_(), group_adjacency_(),
+    node_membership_(), nodes_(), groups_(), min_membership_(0),
+    max_membership_(0), min_group_size_(0), max_group_size_(0)
+{
+    build(number_of_edges, [node_array, group_array, stride](size_t i)
+            {return make_pair(node_array[i*stride], group_array[i*stride]);});
+}
+
+//build the adjacency from the edges
+template <class EdgeAccessor>
+void BipartiteNetwork::build(size_t number_of_edges, EdgeAccessor edge)
+{
+    if (number_of_edges > numeric_limits<Membership>::max())
+    {
+        throw overflow_error(
+                "BipartiteNetwork: too many edges for 32-bit memberships");
+    }
 	size_t nb_nodes = 0;
 	size_t nb_groups = 0;
 	//Determine the number of nodes and groups (brut force)
-	for (size_t i = 0; i < edge_list.size(); i++)
+	for (size_t i = 0; i < number_of_edges; i++)
     {
-    	if (edge_list[i].first > nb_nodes)
+    	if (edge(i).first > nb_nodes)
     	{
-    		nb_nodes = edge_list[i].first;
+    		nb_nodes = edge(i).first;
     	}
-    	if (edge_list[i].second > nb_groups)
+    	if (edge(i).second > nb_groups)
     	{
-    		nb_groups = edge_list[i].second;
+    		nb_groups = edge(i).second;
     	}
     }
     nb_nodes += 1; //the label starts to 0 by convention
     nb_groups += 1; //the label starts to 0 by convention
 
-    //Initialize adjacency lists, nodes an groups
-    node_adjacency_list_ = NodeAdjacencyList(nb_nodes, vector<Group>());
-    group_adjacency_list_ = GroupAdjacencyList(nb_groups, vector<Node>());
+    //Initialize nodes an groups
     nodes_ = vector<Node>(nb_nodes);
-    groups_ = vector<Node>(nb_groups);
+    groups_ = vector<Group>(nb_groups);
     iota(nodes_.begin(),nodes_.end(),0);
     iota(groups_.begin(),groups_.end(),0);
 
-    for (auto & edge : edge_list)
+    //Counting sort, first pass: count the edges of each node and group and
+    //get the offsets from the cumulative sum
+    node_offset_ = vector<Membership>(nb_nodes+1, 0);
+    group_offset_ = vector<Membership>(nb_groups+1, 0);
+    for (size_t i = 0; i < number_of_edges; i++)
+    {
+        node_offset_[edge(i).first+1] += 1;
+        group_offset_[edge(i).second+1] += 1;
+    }
+    partial_sum(node_offset_.begin(), node_offset_.end(),
+            node_offset_.begin());
+    partial_sum(group_offset_.begin(), group_offset_.end(),
+            group_offset_.begin());
+
+    //second pass: place the edges, in the order of the edge list
+    node_adjacency_ = vector<Group>(number_of_edges);
+    group_adjacency_ = vector<Node>(number_of_edges);
+    vector<Membership> node_position(node_offset_.begin(),
+            node_offset_.end()-1);
+    vector<Membership> group_position(group_offset_.begin(),
+            group_offset_.end()-1);
+    node_membership_ = vector<Membership>(number_of_edges);
+    for (size_t i = 0; i < number_of_edges; i++)
     {
-        node_adjacency_list_[edge.first].push_back(edge.second);
-        group_adjacency_list_[edge.second].push_back(edge.first);
+        pair<Node,Group> current_edge = edge(i);
+        size_t node_index = node_position[current_edge.first]++;
+        Membership membership = group_position[current_edge.second]++;
+        node_adjacency_[node_index] = current_edge.second;
+        group_adjacency_[membership] = current_edge.first;
+        node_membership_[node_index] = membership;
     }
 
     //Determine min and max membership
@@ -28,6 +28,7 @@
 #include <utility>
 #include <vector>
 #include <memory>
+#include <cstdint>
 
 namespace schon
 {//start of namespace schon
@@ -35,16 +36,48 @@ namespace schon
 typedef unsigned int Node;
 typedef unsigned int Group;
 typedef std::vector<std::pair<Node,Group>> EdgeList;
-typedef std::vector<std::vector<Group> > NodeAdjacencyList;
-typedef std::vector<std::vector<Node> > GroupAdjacencyList;
+//index of a node among the group members, 32 bits such that the networks
+//and the processes store half as many bytes per edge
+typedef std::uint32_t Membership;
 
 
-//Structure representing an undirected network
+//Read-only view of a contiguous sequence of elements
+template <typename T>
+class Span
+{
+public:
+    //Constructor
+    Span(const T* first, const T* last) : first_(first), last_(last) {}
+
+    //Accessors
+    const T* begin() const
+        {return first_;}
+    const T* end() const
+        {return last_;}
+    std::size_t size() const
+        {return last_ - first_;}
+    const T& operator[](std::size_t index) const
+        {return first_[index];}
+
+private:
+    //Members
+    const T* first_;
+    const T* last_;
+};
+
+
+//Structure representing an undirected network, with adjacency stored in
+//compressed sparse row format: the groups of node n are
+//node_adjacency_[node_offset_[n]:node_offset_[n+1]], and similarly for the
+//members of a group. Each (node,group) pair is identified by a membership,
+//its index in group_adjacency_.
 class BipartiteNetwork
 {
 public:
     //Constructor
     BipartiteNetwork(const EdgeList& edge_list);
+    BipartiteNetwork(const Node* node_array, const Group* group_array,
+            std::size_t number_of_edges, std::size_t stride = 1);
 
     //Accessors
     std::size_t min_membership() const
@@ -57,30 +90,48 @@ public:
         {return max_group_size_;}
 
     std::size_t membership(Node node) const
-    	{return node_adjacency_list_[node].size();}
+    	{return node_offset_[node+1] - node_offset_[node];}
     std::size_t group_size(Group group) const
-    	{return group_adjacency_list_[group].size();}
+    	{return group_offset_[group+1] - group_offset_[group];}
 
     std::size_t size() const
-        {return node_adjacency_list_.size();}
+        {return nodes_.size();}
     std::size_t number_of_nodes() const
-        {return node_adjacency_list_.size();}
+        {return nodes_.size();}
     std::size_t number_of_groups() const
-        {return group_adjacency_list_.size();}
+        {return groups_.size();}
+    std::size_t number_of_edges() const
+        {return node_adjacency_.size();}
 
-    const std::vector<Node>& group_members(Group group) const
-    	{return group_adjacency_list_[group];}
-    const std::vector<Group>& adjacent_groups(Node node) const
-    	{return node_adjacency_list_[node];}
+    Span<Node> group_members(Group group) const
+    	{return Span<Node>(group_adjacency_.data() + group_offset_[group],
+                group_adjacency_.data() + group_offset_[group+1]);}
+    Span<Group> adjacent_groups(Node node) const
+    	{return Span<Group>(node_adjacency_.data() + node_offset_[node],
+                node_adjacency_.data() + node_offset_[node+1]);}
+    Span<Membership> memberships(Node node) const
+    	{return Span<Membership>(node_membership_.data() + node_offset_[node],
+                node_membership_.data() + node_offset_[node+1]);}
+    Membership first_membership(Group group) const
+        {return group_offset_[group];}
+    Node member(Membership membership) const
+        {return group_adjacency_[membership];}
     const std::vector<Node>& nodes() const
         {return nodes_;}
     const std::vector<Group>& groups() const
         {return groups_;}
 
 private:
+    //utility function, edge(i) returns the i-th (node,group) pair
+    template <class EdgeAccessor>
+    void build(std::size_t number_of_edges, EdgeAccessor edge);
+
     //Members
-    NodeAdjacencyList node_adjacency_list_;
-    GroupAdjacencyList group_adjacency_list_;
+    std::vector<Membership> node_offset_;
+    std::vector<Group> node_adjacency_;
+    std::vector<Membership> group_offset_;
+    std::vector<Node> group_adjacency_;
+    std::vector<Membership> node_membership_; //parallel to node_adjacency_
     std::vector<Node> nodes_;
     std::vector<Group> groups_;
     std::size_t min_membership_;
@@ -90,6 +141,9 @@ private:
 
 };
 
+//network shared (read-only) between many processes
+typedef std::shared_ptr<const BipartiteNetwork> SharedNetwork;
+
 }//end of namespace schon
 
 #endif /* BIPARTITENETWORK_HPP_ */
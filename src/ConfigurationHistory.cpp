@@ -0,0 +1,131 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Guillaume St-Onge
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "ConfigurationHistory.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+namespace schon
+{//start of namespace schon
+
+//fill the history with copies of a configuration, sharing a single array
+void ConfigurationHistory::assign(size_t number_of_states,
+        const vector<NodeState>& node_state_vector,
+        const unordered_set<Node>& infected_node_set)
+{
+    clear();
+    Slot slot = append(node_state_vector, infected_node_set);
+    slot_vector_.assign(number_of_states, slot);
+}
+
+//replace a configuration by a new one; the history is reordered as by
+//swapping the replaced configuration with the last one, then replacing the
+//last one
+void ConfigurationHistory::replace(size_t index,
+        const vector<NodeState>& node_state_vector,
+        const unordered_set<Node>& infected_node_set)
+{
+    swap(slot_vector_[index], slot_vector_.back());
+    slot_vector_.pop_back();
+    Slot slot = append(node_state_vector, infected_node_set);
+    slot_vector_.push_back(slot);
+}
+
+//remove all configurations, but keep the memory
+void ConfigurationHistory::clear()
+{
+    arena_.clear();
+    slot_vector_.clear();
+}
+
+//copy a configuration at the end of the arena; when the arena is full, the
+//configurations still in use are first moved to its beginning, and its
+//capacity is at least twice the space in use, so that the cost of the
+//compactions is amortized
+ConfigurationHistory::Slot ConfigurationHistory::append(
+        const vector<NodeState>& node_state_vector,
+        const unordered_set<Node>& infected_node_set)
+{
+    size_t number_of_infected = infected_node_set.size();
+    if (arena_.size() + number_of_infected > arena_.capacity())
+    {
+        compact();
+        arena_.reserve(2*(arena_.size() + number_of_infected));
+    }
+    Slot slot(arena_.size(), number_of_infected);
+    //sorting the set costs I*log(I), a scan of the states N
+    if (number_of_infected*log2(number_of_infected+1) <
+            node_state_vector.size())
+    {
+        arena_.insert(arena_.end(), infected_node_set.begin(),
+                infected_node_set.end());
+        sort(arena_.begin() + slot.first, arena_.end());
+    }
+    else
+    {
+        for (Node node = 0; node < node_state_vector.size(); node++)
+        {
+            if (node_state_vector[node] == I)
+            {
+                arena_.push_back(node);
+            }
+        }
+    }
+    return slot;
+}
+
+//move the arrays in use to the beginning of the arena, in order
+void ConfigurationHistory::compact()
+{
+    vector<size_t> order(slot_vector_.size());
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        order[i] = i;
+    }
+    sort(order.begin(), order.end(), [&](size_t a, size_t b)
+            {return slot_vector_[a] < slot_vector_[b];});
+    size_t end = 0; //of the arrays already moved
+    Slot previous_slot(arena_.size(), 0); //before moving, none yet
+    for (size_t i : order)
+    {
+        Slot& slot = slot_vector_[i];
+        if (slot == previous_slot)
+        {
+            //array shared with the previous slot, already moved
+            slot.first = end - slot.second;
+            continue;
+        }
+        previous_slot = slot;
+        copy(arena_.begin() + slot.first,
+                arena_.begin() + slot.first + slot.second,
+                arena_.begin() + end);
+        slot.first = end;
+        end += slot.second;
+    }
+    arena_.resize(end);
+}
+
+}//end of namespace schon
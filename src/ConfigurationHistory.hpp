@@ -0,0 +1,86 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Guillaume St-Onge
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CONFIGURATIONHISTORY_HPP_
+#define CONFIGURATIONHISTORY_HPP_
+
+#include "ContagionProcess.hpp"
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace schon
+{//start of namespace schon
+
+//fixed number of configurations of infected nodes for the quasistationary
+//state, each stored as a sorted array of nodes in a single arena; the
+//configurations are never modified, so slots can share the same array
+class ConfigurationHistory
+{
+public:
+    //Constructor
+    ConfigurationHistory() : arena_(), slot_vector_() {}
+
+    //Accessors
+    std::size_t size() const
+        {return slot_vector_.size();}
+    bool empty() const
+        {return slot_vector_.empty();}
+    Span<Node> operator[](std::size_t index) const
+        {return Span<Node>(arena_.data() + slot_vector_[index].first,
+                arena_.data() + slot_vector_[index].first
+                + slot_vector_[index].second);}
+    std::size_t footprint() const //in bytes
+        {return arena_.capacity()*sizeof(Node)
+            + slot_vector_.capacity()*sizeof(Slot);}
+
+    //Mutators
+    //the configuration is given both as the state of the nodes and the set
+    //of infected nodes, the cheapest to put in order being used
+    void assign(std::size_t number_of_states,
+            const std::vector<NodeState>& node_state_vector,
+            const std::unordered_set<Node>& infected_node_set);
+    void replace(std::size_t index,
+            const std::vector<NodeState>& node_state_vector,
+            const std::unordered_set<Node>& infected_node_set);
+    void clear();
+
+private:
+    //position and length of a configuration in the arena
+    typedef std::pair<std::size_t,std::size_t> Slot;
+
+    //Members
+    std::vector<Node> arena_;
+    std::vector<Slot> slot_vector_;
+
+    //utility functions
+    Slot append(const std::vector<NodeState>& node_state_vector,
+            const std::unordered_set<Node>& infected_node_set);
+    void compact();
+};
+
+}//end of namespace schon
+
+#endif /* CONFIGURATIONHISTORY_HPP_ */
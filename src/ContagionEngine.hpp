@@ -0,0 +1,138 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 Guillaume St-Onge
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CONTAGIONENGINE_HPP_
+#define CONTAGIONENGINE_HPP_
+
+#include "BaseContagion.hpp"
+#include <vector>
+#include <cmath>
+
+namespace schon
+{//start of namespace schon
+
+
+//base class of the processes: the evolution loop calls the events of the
+//process Derived directly, such that they can be inlined, which requires
+//Derived to declare ContagionEngine<Derived> as a friend
+template <class Derived>
+class ContagionEngine : public BaseContagion
+{
+public:
+    //Constructor
+    ContagionEngine(SharedNetwork network) : BaseContagion(network) {}
+
+    //Mutators
+    void evolve(double period, double decorrelation_time=1,
+            bool measure=false, bool quasistationary=false) override;
+
+protected:
+    //utility functions
+    void measure_and_store(bool measure, bool quasistationary);
+    template <class EventSet, class Update>
+    static void apply_updates(EventSet& event_set,
+            std::vector<Update>& update_vector);
+};
+
+//perform the evolution of the process over a period of time and perform
+//measures after each decorrelation time if needed
+template <class Derived>
+void ContagionEngine<Derived>::evolve(double period,
+        double decorrelation_time, bool measure, bool quasistationary)
+{
+    //the qualified calls are bound statically and can be inlined
+    Derived& process = static_cast<Derived&>(*this);
+    if (quasistationary and history_.empty())
+    {
+        initialize_history();
+    }
+    double initial_time = current_time_;
+    double lifetime = process.Derived::get_lifetime();
+    while(last_event_time_ + lifetime - initial_time < period)
+    {
+        time_since_last_measure_ += last_event_time_ + lifetime
+            - current_time_; //after the coming event
+        if (time_since_last_measure_ > decorrelation_time)
+        {
+            time_since_last_measure_ -= decorrelation_time;
+            measure_and_store(measure, quasistationary);
+        }
+        process.Derived::next_event();
+        lifetime = process.Derived::get_lifetime();
+        if (std::isinf(lifetime) and quasistationary)
+        {
+            get_configuration_from_history();
+            lifetime = process.Derived::get_lifetime();
+        }
+    }
+    time_since_last_measure_ += period - (last_event_time_ - initial_time);
+    //if we need to perform a last measure
+    if (time_since_last_measure_ > decorrelation_time)
+    {
+        time_since_last_measure_ -= decorrelation_time;
+        measure_and_store(measure, quasistationary);
+    }
+    current_time_ = initial_time + period;
+}
+
+//perform the measures and store the configuration, if needed
+template <class Derived>
+void ContagionEngine<Derived>::measure_and_store(bool measure,
+        bool quasistationary)
+{
+    if (measure)
+    {
+        for(std::size_t i = 0; i < measure_vector_.size(); i++)
+        {
+            measure_vector_[i] -> measure(this);
+        }
+    }
+    if (quasistationary)
+    {
+        store_configuration();
+    }
+}
+
+//set a batch of weights in an event set; the batch is emptied even if a
+//weight is rejected, such that it is not replayed by the next event
+template <class Derived>
+template <class EventSet, class Update>
+inline void ContagionEngine<Derived>::apply_updates(EventSet& event_set,
+        std::vector<Update>& update_vector)
+{
+    try
+    {
+        event_set.set_weights(update_vector.begin(), update_vector.end());
+    }
+    catch (...)
+    {
+        update_vector.clear();
+        throw;
+    }
+    update_vector.clear();
+}
+
+}//end of namespace schon
+
+#endif /* CONTAGIONENGINE_HPP_ */
@@ -29,23 +29,22 @@
 #include "BipartiteNetwork.hpp"
 #include <unordered_set>
 #include <unordered_map>
-#include <tuple>
 #include <utility>
-#include "SamplableSet/hash_specialization.hpp"
+#include <cstdint>
+#include <array>
 
 namespace schon
 {//start of namespace schon
 
 enum NodeState {S, I, R, COUNT};
 const unsigned int STATECOUNT = static_cast<unsigned int>(NodeState::COUNT);
-enum Action {RECOVERY,INFECTION};
-enum Actor {GROUP,NODE};
 
-typedef unsigned int Label;
-typedef std::tuple<Actor,Action,Label> Event;
+//events are packed in a single integer: the recovery of node n is the event
+//n and the infection in group g is the event N+g, for a network of N nodes
+typedef std::uint64_t Event;
 
-typedef std::vector<std::vector<Node>> GroupState; //NodeState is entry
-typedef std::unordered_map<Node,std::size_t> GroupStatePosition;
+//number of members of a group in each state, NodeState is entry
+typedef std::array<unsigned int,STATECOUNT> GroupState;
 
 //abstract class with minimal structure for the simulation of contagions
 class ContagionProcess
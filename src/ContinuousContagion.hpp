@@ -0,0 +1,249 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 Guillaume St-Onge
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CONTINUOUSCONTAGION_HPP_
+#define CONTINUOUSCONTAGION_HPP_
+
+#include "SamplableSet/SamplableSet.hpp"
+#include "ContagionEngine.hpp"
+#include <utility>
+#include <vector>
+#include <limits>
+#include <stdexcept>
+
+namespace schon
+{//start of namespace schon
+
+
+//base class of the continuous time processes, where each infected node
+//recovers at a fixed rate into RecoveredState and each group infects one of
+//its susceptible nodes at the rate given by Derived::get_infection_rate,
+//which requires Derived to declare this class as a friend
+template <class Derived, NodeState RecoveredState = S>
+class ContinuousContagion : public ContagionEngine<Derived>
+{
+public:
+    //Constructor
+    //the event set has a fixed range of rates, unless adaptive
+    ContinuousContagion(SharedNetwork network, double recovery_rate,
+            const std::pair<double,double>& rate_bounds,
+            bool adaptive=false);
+
+    //Accessors
+    double get_lifetime() const
+        {return event_set_.size() == 0 ?
+            std::numeric_limits<double>::infinity() :
+            1/event_set_.total_weight();}
+
+    //Mutators
+    void clear();
+
+protected:
+    typedef ContagionEngine<Derived> Engine;
+    friend Engine; //the evolution loop calls the events directly
+    using Engine::network_;
+    using Engine::node_state_vector_;
+    using Engine::infected_node_set_;
+    using Engine::number_of_recovered_nodes_;
+    using Engine::current_time_;
+    using Engine::last_event_time_;
+    using Engine::gen_;
+
+    //Members
+    double recovery_rate_;
+    sset::DenseSamplableSet<Event> event_set_;
+    std::vector<std::pair<Event,double>> rate_update_vector_;
+
+    //utility functions
+    inline double get_infection_rate(Group group) const
+        {return static_cast<const Derived&>(*this).Derived::
+            get_infection_rate(group);}
+    inline void update_group_rate(Group group, Membership membership,
+            NodeState previous_state, NodeState new_state);
+    inline void apply_rate_updates()
+        {Engine::apply_updates(event_set_, rate_update_vector_);}
+
+    inline void infect(Node node);
+    inline void recover(Node node);
+    inline void next_event();
+    void rebuild_event_set();
+    bool recovers_to_susceptible() const
+        {return RecoveredState == S;}
+};
+
+//constructor of the class from a shared network
+template <class Derived, NodeState RecoveredState>
+ContinuousContagion<Derived,RecoveredState>::ContinuousContagion(
+        SharedNetwork network, double recovery_rate,
+        const std::pair<double,double>& rate_bounds, bool adaptive):
+    Engine(network),
+    recovery_rate_(recovery_rate),
+    event_set_(rate_bounds.first,rate_bounds.second,adaptive),
+    rate_update_vector_()
+{
+    event_set_.reserve(network_->size() + network_->number_of_groups());
+}
+
+//update the event group rate
+template <class Derived, NodeState RecoveredState>
+inline void ContinuousContagion<Derived,RecoveredState>::update_group_rate(
+        Group group, Membership membership, NodeState previous_state,
+        NodeState new_state)
+{
+    this->update_group_state(group,membership,previous_state,new_state);
+    //update event set with new rate, positive rates are set in batch
+    double new_rate = get_infection_rate(group);
+    if (new_rate > 0)
+    {
+        rate_update_vector_.push_back(
+                std::make_pair(this->infection_event(group),new_rate));
+    }
+    else
+    {
+        event_set_.erase(this->infection_event(group));
+    }
+}
+
+//infect a node
+template <class Derived, NodeState RecoveredState>
+inline void ContinuousContagion<Derived,RecoveredState>::infect(Node node)
+{
+    if (node_state_vector_[node] == S)
+    {
+        node_state_vector_[node] = I;
+        infected_node_set_.insert(node);
+        Span<Group> groups = network_->adjacent_groups(node);
+        Span<Membership> memberships = network_->memberships(node);
+        for (std::size_t i = 0; i < groups.size(); i++)
+        {
+            update_group_rate(groups[i],memberships[i],S,I);
+        }
+        //create a recovery event for the node
+        rate_update_vector_.push_back(
+                std::make_pair(this->recovery_event(node),recovery_rate_));
+        apply_rate_updates();
+    }
+    else
+    {
+        throw std::runtime_error(
+                "Infection attempt: the node is not susceptible");
+    }
+}
+
+//recover a node
+template <class Derived, NodeState RecoveredState>
+inline void ContinuousContagion<Derived,RecoveredState>::recover(Node node)
+{
+    if (node_state_vector_[node] == I)
+    {
+        node_state_vector_[node] = RecoveredState;
+        if (RecoveredState != S)
+        {
+            number_of_recovered_nodes_ += 1;
+        }
+        infected_node_set_.erase(node);
+        Span<Group> groups = network_->adjacent_groups(node);
+        Span<Membership> memberships = network_->memberships(node);
+        for (std::size_t i = 0; i < groups.size(); i++)
+        {
+            update_group_rate(groups[i],memberships[i],I,RecoveredState);
+        }
+        apply_rate_updates();
+        //erase the recovery event for the node
+        event_set_.erase(this->recovery_event(node));
+    }
+    else
+    {
+        throw std::runtime_error("Recovery attempt: the node is not infected");
+    }
+}
+
+//advance the process to the next step by performing infection/recovery
+//it is assumed that the lifetime is finite
+template <class Derived, NodeState RecoveredState>
+inline void ContinuousContagion<Derived,RecoveredState>::next_event()
+{
+    current_time_ = last_event_time_ + ContinuousContagion::get_lifetime();
+    //select a group proportionally to its weight
+    std::pair<Event, double> event_weight_pair =
+        (event_set_.sample_ext_RNG(gen_)).value();
+    Event event = event_weight_pair.first;
+    if (this->is_recovery_event(event))
+    {
+        //node-based recovery event
+        Node node = event;
+        ContinuousContagion::recover(node);
+    }
+    else
+    {
+        //Groub-based infection event
+        Group group = this->event_group(event);
+        Node node = this->random_node(group, S);
+        ContinuousContagion::infect(node);
+    }
+    last_event_time_ = current_time_;
+}
+
+//recompute the rates of all events and build the event set at once
+//overload BaseContagion
+template <class Derived, NodeState RecoveredState>
+void ContinuousContagion<Derived,RecoveredState>::rebuild_event_set()
+{
+    std::vector<std::pair<Event,double>> rate_vector;
+    rate_vector.reserve(infected_node_set_.size()
+            + network_->number_of_groups());
+    for (Node node = 0; node < network_->size(); node++)
+    {
+        if (node_state_vector_[node] == I)
+        {
+            rate_vector.push_back(
+                    std::make_pair(this->recovery_event(node),
+                        recovery_rate_));
+        }
+    }
+    for (Group group : network_->groups())
+    {
+        double rate = get_infection_rate(group);
+        if (rate > 0)
+        {
+            rate_vector.push_back(
+                    std::make_pair(this->infection_event(group),rate));
+        }
+    }
+    event_set_.assign(rate_vector.begin(),
+            rate_vector.end());
+}
+
+//clear the state; as if all node became susceptible at this time
+//overload BaseContagion
+template <class Derived, NodeState RecoveredState>
+void ContinuousContagion<Derived,RecoveredState>::clear()
+{
+    BaseContagion::clear();
+    event_set_.clear(); //to avoid numerical error accumulation
+}
+
+}//end of namespace schon
+
+#endif /* CONTINUOUSCONTAGION_HPP_ */
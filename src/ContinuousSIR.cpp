@@ -25,6 +25,7 @@
 #include "ContinuousSIR.hpp"
 #include <optional>
 #include <utility>
+#include <memory>
 #include <algorithm>
 #include <iostream>
 #include <exception>
@@ -35,15 +36,23 @@ using namespace std;
 namespace schon
 {//start of namespace schon
 
-//constructor of the class
+//constructor of the class from an edge list
 ContinuousSIR::ContinuousSIR(const EdgeList& edge_list, double recovery_rate,
         const vector<vector<double>>& infection_rate,
         const vector<double>& group_transmission_rate):
-    BaseContagion(edge_list),
-    recovery_rate_(recovery_rate),
+    ContinuousSIR(make_shared<const BipartiteNetwork>(edge_list),
+            recovery_rate, infection_rate, group_transmission_rate)
+{
+}
+
+//constructor of the class from a shared network
+ContinuousSIR::ContinuousSIR(SharedNetwork network, double recovery_rate,
+        const vector<vector<double>>& infection_rate,
+        const vector<double>& group_transmission_rate):
+    ContinuousContagion<ContinuousSIR, R>(network, recovery_rate,
+            make_pair(1.,1.)),
     infection_rate_(infection_rate),
-    group_transmission_rate_(group_transmission_rate),
-    event_set_(1.,1.)
+    group_transmission_rate_(group_transmission_rate)
 {
     //determine min/max rate upper and lower bounds
     double min_transmission = std::numeric_limits<double>::infinity();
@@ -82,121 +91,8 @@ ContinuousSIR::ContinuousSIR(const EdgeList& edge_list, double recovery_rate,
             }
         }
     }
-    event_set_ = sset::SamplableSet<Event>(min,max); //set true bounds
-
-}
-
-//update the event group rate
-inline void ContinuousSIR::update_group_rate(Group group, Node node,
-        NodeState previous_state, NodeState new_state)
-{
-    GroupState & group_state = group_state_vector_[group];
-    size_t position = group_state_position_vector_[group][node];
-    if (position < group_state[previous_state].size())
-    {
-        //node not in the back, put node in the back position
-        swap(group_state[previous_state][position],
-                group_state[previous_state].back());
-        //also update the position of the node in the back
-        Node back_node = group_state[previous_state][position];
-        group_state_position_vector_[group][back_node] = position;
-    }
-    //put node in new group state
-    group_state[previous_state].pop_back();
-    group_state_position_vector_[group][node] = group_state[new_state].size();
-    group_state[new_state].push_back(node);
-    //update event set with new rate
-    double new_rate = get_infection_rate(group);
-    if (new_rate > 0)
-    {
-        event_set_.set_weight(make_tuple(GROUP,INFECTION,group),new_rate);
-    }
-    else
-    {
-        event_set_.erase(make_tuple(GROUP,INFECTION,group));
-    }
-}
-
-//infect a node
-inline void ContinuousSIR::infect(Node node)
-{
-    if (node_state_vector_[node] == S)
-    {
-        node_state_vector_[node] = I;
-        infected_node_set_.insert(node);
-        for (Group group : network_.adjacent_groups(node))
-        {
-            update_group_rate(group,node,S,I);
-        }
-        //create a recovery event for the node
-        event_set_.insert(make_tuple(NODE,RECOVERY,node), recovery_rate_);
-    }
-    else
-    {
-        throw runtime_error("Infection attempt: the node is not susceptible");
-    }
-}
-
-//recover a node
-inline void ContinuousSIR::recover(Node node)
-{
-    if (node_state_vector_[node] == I)
-    {
-        node_state_vector_[node] = R;
-        infected_node_set_.erase(node);
-        for (Group group : network_.adjacent_groups(node))
-        {
-            update_group_rate(group,node,I,R);
-        }
-        //erase the recovery event for the node
-        event_set_.erase(make_tuple(NODE,RECOVERY,node));
-    }
-    else
-    {
-        throw runtime_error("Recovery attempt: the node is not infected");
-    }
+    event_set_ = sset::DenseSamplableSet<Event>(min,max); //set true bounds
+    event_set_.reserve(network_->size() + network_->number_of_groups());
 }
 
-
-//advance the process to the next step by performing infection/recovery
-//it is assumed that the lifetime is finite
-inline void ContinuousSIR::next_event()
-{
-    current_time_ = last_event_time_ + get_lifetime();
-    //select a group proportionally to its weight
-    pair<Event, double> event_weight_pair = (event_set_.sample()).value();
-    const Event& event = event_weight_pair.first;
-    if (get<0>(event) == NODE and get<1>(event) == RECOVERY)
-    {
-        //node-based recovery event
-        Node node = get<2>(event);
-        recover(node);
-    }
-    else if (get<0>(event) == GROUP and get<1>(event) == INFECTION)
-    {
-        //Groub-based infection event
-        Group group = get<2>(event);
-        Node node = random_node(group, S);
-        infect(node);
-    }
-    else
-    {
-        throw runtime_error("Unallowed type of event");
-    }
-    last_event_time_ = current_time_;
-}
-
-
-
-//clear the state; as if all node became susceptible at this time
-//clear all measures as well
-//overload BaseContagion
-void ContinuousSIR::clear()
-{
-    BaseContagion::clear();
-    event_set_.clear(); //to avoid numerical error accumulation
-}
-
-
-
 }//end of namespace schon
@@ -25,8 +25,7 @@
 #ifndef CONTINUOUSSIS_HPP_
 #define CONTINUOUSSIS_HPP_
 
-#include "SamplableSet/SamplableSet.hpp"
-#include "BaseContagion.hpp"
+#include "ContinuousContagion.hpp"
 #include <functional>
 
 namespace schon
@@ -34,42 +33,27 @@ namespace schon
 
 
 //class to simulate SIS process on networks
-class ContinuousSIS : public BaseContagion
+class ContinuousSIS : public ContinuousContagion<ContinuousSIS>
 {
 public:
     //Constructor
     ContinuousSIS(const EdgeList& edge_list, double recovery_rate,
             const std::vector<std::vector<double>>& infection_rate,
             const std::vector<double>& group_transmission_rate);
-
-    //Accessors
-    double get_lifetime() const
-        {return event_set_.size() == 0 ?
-            std::numeric_limits<double>::infinity() :
-            1/event_set_.total_weight();}
-
-    //Mutators
-    void clear();
+    ContinuousSIS(SharedNetwork network, double recovery_rate,
+            const std::vector<std::vector<double>>& infection_rate,
+            const std::vector<double>& group_transmission_rate);
 
 protected:
     //Members
-    double recovery_rate_;
     std::vector<std::vector<double>> infection_rate_;
     std::vector<double> group_transmission_rate_;
-    sset::SamplableSet<Event> event_set_;
 
     //utility functions
-    inline double get_recovery_rate(Group group) const
-        {return recovery_rate_;}
     inline double get_infection_rate(Group group) const
-        {return group_transmission_rate_[group]*group_state_vector_[group][S].size()*infection_rate_[network_.group_size(group)][group_state_vector_[group][I].size()];}
-    inline void update_group_rate(Group group, Node node,
-            NodeState previous_state, NodeState new_state);
-
-    inline void infect(Node node);
-    inline void recover(Node node);
-    inline void next_event();
-
+        {return group_transmission_rate_[group]*group_state_vector_[group][S]*infection_rate_[network_->group_size(group)][group_state_vector_[group][I]];}
+    //the events call the infection rate directly
+    friend class ContinuousContagion<ContinuousSIS>;
 };
 
 }//end of namespace schon
@@ -25,6 +25,7 @@
 #include "DiscreteSIS.hpp"
 #include <optional>
 #include <utility>
+#include <memory>
 #include <iostream>
 #include <exception>
 #include <cmath>
@@ -35,16 +36,25 @@ using namespace std;
 namespace schon
 {//start of namespace schon
 
-//constructor of the class
+//constructor of the class from an edge list
 DiscreteSIS::DiscreteSIS(const EdgeList& edge_list, double recovery_probability,
         const std::vector<std::vector<double>>& infection_probability):
-    BaseContagion(edge_list),
+    DiscreteSIS(make_shared<const BipartiteNetwork>(edge_list),
+            recovery_probability, infection_probability)
+{
+}
+
+//constructor of the class from a shared network
+DiscreteSIS::DiscreteSIS(SharedNetwork network, double recovery_probability,
+        const std::vector<std::vector<double>>& infection_probability):
+    ContagionEngine<DiscreteSIS>(network),
     recovery_probability_(recovery_probability),
     recovery_propensity_(-log(1-recovery_probability)),
     infection_probability_(infection_probability),
     infection_propensity_(infection_probability.size(),vector<double>()),
     infection_event_set_(1.,1.),
     recovery_event_set_(1.,1.),
+    propensity_update_vector_(),
     poisson_dist_(1.)
 {
     //calculate Poisson rate equivalent for each probability
@@ -67,31 +77,22 @@ DiscreteSIS::DiscreteSIS(const EdgeList& edge_list, double recovery_probability,
             }
         }
     }
-    max *= network_.max_group_size(); //upper bound
-    infection_event_set_ = sset::SamplableSet<Group>(min,max); //set true bounds
+    max *= network_->max_group_size(); //upper bound
+    infection_event_set_ = sset::DenseSamplableSet<Group>(min,max); //set true bounds
+    infection_event_set_.reserve(network_->number_of_groups());
+    recovery_event_set_.reserve(network_->size());
 }
 
 //update the group state and the infection propensity
-inline void DiscreteSIS::update_infection_propensity(Group group, Node node,
-        NodeState previous_state, NodeState new_state)
+inline void DiscreteSIS::update_infection_propensity(Group group,
+        Membership membership, NodeState previous_state, NodeState new_state)
 {
-    GroupState & group_state = group_state_vector_[group];
-    size_t position = group_state_position_vector_[group][node];
-    //if node not in the back, put node in the back position
-    swap(group_state[previous_state][position],
-            group_state[previous_state].back());
-    //also update the position of the node in the back
-    Node back_node = group_state[previous_state][position];
-    group_state_position_vector_[group][back_node] = position;
-    //put node in new group state
-    group_state[previous_state].pop_back();
-    group_state_position_vector_[group][node] = group_state[new_state].size();
-    group_state[new_state].push_back(node);
-    //update event set with new propensity
+    update_group_state(group,membership,previous_state,new_state);
+    //update event set with new propensity, positive ones are set in batch
     double new_propensity = get_infection_propensity(group);
     if (new_propensity > 0)
     {
-        infection_event_set_.set_weight(group,new_propensity);
+        propensity_update_vector_.push_back(make_pair(group,new_propensity));
     }
     else
     {
@@ -106,10 +107,13 @@ inline void DiscreteSIS::infect(Node node)
     {
         node_state_vector_[node] = I;
         infected_node_set_.insert(node);
-        for (Group group : network_.adjacent_groups(node))
+        Span<Group> groups = network_->adjacent_groups(node);
+        Span<Membership> memberships = network_->memberships(node);
+        for (size_t i = 0; i < groups.size(); i++)
         {
-            update_infection_propensity(group,node,S,I);
+            update_infection_propensity(groups[i],memberships[i],S,I);
         }
+        apply_updates(infection_event_set_, propensity_update_vector_);
         //create a recovery event for the node
         recovery_event_set_.insert(node, 1.);
     }
@@ -126,10 +130,13 @@ inline void DiscreteSIS::recover(Node node)
     {
         node_state_vector_[node] = S;
         infected_node_set_.erase(node);
-        for (Group group : network_.adjacent_groups(node))
+        Span<Group> groups = network_->adjacent_groups(node);
+        Span<Membership> memberships = network_->memberships(node);
+        for (size_t i = 0; i < groups.size(); i++)
         {
-            update_infection_propensity(group,node,I,S);
+            update_infection_propensity(groups[i],memberships[i],I,S);
         }
+        apply_updates(infection_event_set_, propensity_update_vector_);
         //erase the recovery event for the node
         recovery_event_set_.erase(node);
     }
@@ -143,7 +150,7 @@ inline void DiscreteSIS::recover(Node node)
 //advance the process to the next step by performing infection/recovery
 inline void DiscreteSIS::next_event()
 {
-    current_time_ = last_event_time_ + get_lifetime();
+    current_time_ = last_event_time_ + DiscreteSIS::get_lifetime();
     //get the number of recoveries and assign them
     poisson_dist_ = poisson_distribution<int>(
             recovery_propensity_*recovery_event_set_.size());
@@ -152,7 +159,7 @@ inline void DiscreteSIS::next_event()
     for (int i = 0; i < nb_rec; i++)
     {
         pair<Node,double> node_weight_pair =
-            (recovery_event_set_.sample()).value();
+            (recovery_event_set_.sample_ext_RNG(gen_)).value();
         new_susceptible.insert(node_weight_pair.first);
     }
     //get the number of infections and assign them
@@ -163,7 +170,7 @@ inline void DiscreteSIS::next_event()
     for (int i = 0; i < nb_inf; i++)
     {
         pair<Group,double> group_weight_pair =
-            (infection_event_set_.sample()).value();
+            (infection_event_set_.sample_ext_RNG(gen_)).value();
         Group group = group_weight_pair.first;
         //choose uniformly among susceptible
         new_infected.insert(random_node(group, S));
@@ -171,16 +178,44 @@ inline void DiscreteSIS::next_event()
     //perform recovery and infections
     for (Node node : new_susceptible)
     {
-        recover(node);
+        DiscreteSIS::recover(node);
     }
     for (Node node : new_infected)
     {
-        infect(node);
+        DiscreteSIS::infect(node);
     }
     last_event_time_ = current_time_;
 }
 
 
+//recompute the propensities of all events and build the event sets at once
+//overload BaseContagion
+void DiscreteSIS::rebuild_event_set()
+{
+    vector<pair<Group,double>> propensity_vector;
+    for (Group group : network_->groups())
+    {
+        double propensity = get_infection_propensity(group);
+        if (propensity > 0)
+        {
+            propensity_vector.push_back(make_pair(group,propensity));
+        }
+    }
+    infection_event_set_.assign(propensity_vector.begin(),
+            propensity_vector.end());
+    vector<pair<Node,double>> recovery_vector;
+    recovery_vector.reserve(infected_node_set_.size());
+    for (Node node = 0; node < network_->size(); node++)
+    {
+        if (node_state_vector_[node] == I)
+        {
+            recovery_vector.push_back(make_pair(node,1.));
+        }
+    }
+    recovery_event_set_.assign(recovery_vector.begin(),
+            recovery_vector.end());
+}
+
 //clear the state; as if all node became susceptible at this time
 //clear all measures as well
 //overload BaseContagion
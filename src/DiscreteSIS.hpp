@@ -25,19 +25,21 @@
 #ifndef DISCRETESIS_HPP_
 #define DISCRETESIS_HPP_
 
-#include "BaseContagion.hpp"
+#include "ContagionEngine.hpp"
 
 namespace schon
 {//start of namespace schon
 
 
 //class to simulate SIS process on networks
-class DiscreteSIS : public BaseContagion
+class DiscreteSIS : public ContagionEngine<DiscreteSIS>
 {
 public:
     //Constructor
     DiscreteSIS(const EdgeList& edge_list, double recovery_probability,
                 const std::vector<std::vector<double>>& infection_probability);
+    DiscreteSIS(SharedNetwork network, double recovery_probability,
+                const std::vector<std::vector<double>>& infection_probability);
 
     //Accessors
     double get_lifetime() const
@@ -53,21 +55,25 @@ protected:
     double recovery_propensity_;
     std::vector<std::vector<double>> infection_probability_; //per node in group
     std::vector<std::vector<double>> infection_propensity_; //Poisson rate equiv
-    sset::SamplableSet<Group> infection_event_set_;
-    sset::SamplableSet<Node> recovery_event_set_;
+    sset::DenseSamplableSet<Group> infection_event_set_;
+    sset::DenseSamplableSet<Node> recovery_event_set_;
+    std::vector<std::pair<Group,double>> propensity_update_vector_;
     std::poisson_distribution<int> poisson_dist_;
 
     //utility functions
     inline double get_infection_propensity(Group group) const
-        {return infection_propensity_[network_.group_size(group)]
-            [group_state_vector_[group][I].size()]
-                *group_state_vector_[group][S].size();}
-    inline void update_infection_propensity(Group group, Node node,
+        {return infection_propensity_[network_->group_size(group)]
+            [group_state_vector_[group][I]]
+                *group_state_vector_[group][S];}
+    inline void update_infection_propensity(Group group, Membership membership,
             NodeState previous_state, NodeState new_state);
 
     inline void infect(Node node);
     inline void recover(Node node);
     inline void next_event();
+    //the evolution loop calls the events directly
+    friend class ContagionEngine<DiscreteSIS>;
+    void rebuild_event_set();
 };
 
 }//end of namespace schon
@@ -0,0 +1,123 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Guillaume St-Onge
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "Ensemble.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <stdexcept>
+
+using namespace std;
+
+namespace schon
+{//start of namespace schon
+
+//constructor of the class
+Ensemble::Ensemble(const ProcessFactory& factory,
+        size_t number_of_replicas, size_t number_of_threads):
+    factory_(factory),
+    number_of_replicas_(number_of_replicas),
+    number_of_threads_(number_of_threads),
+    measure_vector_()
+{
+    if (number_of_threads_ == 0)
+    {
+        number_of_threads_ = max(thread::hardware_concurrency(), 1u);
+    }
+}
+
+//evolve each replica over a burn-in period without measure, then over a
+//period with measures; the measures of all replicas are merged in the
+//order of the replicas, independently of the scheduling of the threads
+void Ensemble::run(double burn_in, double period, double decorrelation_time,
+        bool quasistationary)
+{
+    vector<vector<shared_ptr<Measure>>> replica_measure_vector(
+            number_of_replicas_);
+    atomic<size_t> next_replica(0);
+    atomic<bool> failed(false);
+    exception_ptr error = nullptr;
+    //each worker takes the next replica as soon as it is done with one,
+    //which balances the load between replicas of different durations
+    auto worker = [&]()
+    {
+        size_t replica;
+        while ((replica = next_replica++) < number_of_replicas_ and
+                not failed)
+        {
+            try
+            {
+                shared_ptr<BaseContagion> process = factory_(replica);
+                process->evolve(burn_in, decorrelation_time, false,
+                        quasistationary);
+                process->evolve(period, decorrelation_time, true,
+                        quasistationary);
+                replica_measure_vector[replica] =
+                    process->get_measure_vector();
+            }
+            catch (...)
+            {
+                if (not failed.exchange(true))
+                {
+                    error = current_exception();
+                }
+            }
+        }
+    };
+    vector<thread> thread_vector;
+    for (size_t i = 1; i < min(number_of_threads_, number_of_replicas_); i++)
+    {
+        thread_vector.push_back(thread(worker));
+    }
+    worker(); //the calling thread works too
+    for (thread& t : thread_vector)
+    {
+        t.join();
+    }
+    if (error)
+    {
+        rethrow_exception(error);
+    }
+
+    //merge the measures
+    measure_vector_.clear();
+    if (number_of_replicas_ > 0)
+    {
+        measure_vector_ = replica_measure_vector[0];
+    }
+    for (size_t replica = 1; replica < number_of_replicas_; replica++)
+    {
+        if (replica_measure_vector[replica].size() != measure_vector_.size())
+        {
+            throw runtime_error("Replicas do not perform the same measures");
+        }
+        for (size_t i = 0; i < measure_vector_.size(); i++)
+        {
+            measure_vector_[i]->merge(*replica_measure_vector[replica][i]);
+        }
+    }
+}
+
+}//end of namespace schon
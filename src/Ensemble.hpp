@@ -0,0 +1,72 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Guillaume St-Onge
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef ENSEMBLE_HPP_
+#define ENSEMBLE_HPP_
+
+#include "BaseContagion.hpp"
+#include <functional>
+#include <memory>
+#include <thread>
+
+namespace schon
+{//start of namespace schon
+
+//return a ready to evolve process for a given replica index
+typedef std::function<std::shared_ptr<BaseContagion>(std::size_t)>
+    ProcessFactory;
+
+//class to evolve independent realizations of a process in parallel and
+//merge their measures
+class Ensemble
+{
+public:
+    //Constructor
+    Ensemble(const ProcessFactory& factory, std::size_t number_of_replicas,
+            std::size_t number_of_threads = 0);
+
+    //Accessors
+    std::size_t number_of_replicas() const
+        {return number_of_replicas_;}
+    std::size_t number_of_threads() const
+        {return number_of_threads_;}
+    const std::vector<std::shared_ptr<Measure>>& get_measure_vector() const
+        {return measure_vector_;}
+
+    //Mutators
+    void run(double burn_in, double period, double decorrelation_time=1,
+            bool quasistationary=false);
+
+private:
+    //Members
+    ProcessFactory factory_;
+    std::size_t number_of_replicas_;
+    std::size_t number_of_threads_;
+    std::vector<std::shared_ptr<Measure>> measure_vector_;
+};
+
+}//end of namespace schon
+
+#endif /* ENSEMBLE_HPP_ */
@@ -0,0 +1,137 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Guillaume St-Onge
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef GENERICGROUPSIS_HPP_
+#define GENERICGROUPSIS_HPP_
+
+#include "ContinuousContagion.hpp"
+#include "GroupRate.hpp"
+#include <memory>
+#include <limits>
+#include <stdexcept>
+
+namespace schon
+{//start of namespace schon
+
+
+//class to simulate SIS process on networks, where the infection rate of a
+//group is given by a rate policy (see GroupRate.hpp) inlined in the engine
+template <class RatePolicy>
+class GenericGroupSIS :
+    public ContinuousContagion<GenericGroupSIS<RatePolicy> >
+{
+public:
+    //Constructor
+    //the rate bounds are an initial guess, the range of rates of the event
+    //set being extended if a rate falls outside of it
+    GenericGroupSIS(const EdgeList& edge_list, double recovery_rate,
+            const RatePolicy& infection_rate,
+            const std::pair<double,double>& rate_bounds);
+    GenericGroupSIS(SharedNetwork network, double recovery_rate,
+            const RatePolicy& infection_rate,
+            const std::pair<double,double>& rate_bounds);
+    //the rate bounds are obtained from the rates of all group states
+    GenericGroupSIS(const EdgeList& edge_list, double recovery_rate,
+            const RatePolicy& infection_rate);
+    GenericGroupSIS(SharedNetwork network, double recovery_rate,
+            const RatePolicy& infection_rate);
+
+protected:
+    typedef ContinuousContagion<GenericGroupSIS<RatePolicy> > Contagion;
+    friend Contagion; //the events call the infection rate directly
+    using Contagion::network_;
+    using Contagion::group_state_vector_;
+
+    //Constructor with a fixed range of rates, unless adaptive
+    GenericGroupSIS(SharedNetwork network, double recovery_rate,
+            const RatePolicy& infection_rate,
+            const std::pair<double,double>& rate_bounds, bool adaptive);
+
+    //Members
+    RatePolicy infection_rate_;
+
+    //utility functions
+    inline double get_infection_rate(Group group) const
+        {return infection_rate_(network_->group_size(group),
+                group_state_vector_[group][I]);}
+};
+
+//constructor of the class from an edge list
+template <class RatePolicy>
+GenericGroupSIS<RatePolicy>::GenericGroupSIS(const EdgeList& edge_list,
+        double recovery_rate, const RatePolicy& infection_rate,
+        const std::pair<double,double>& rate_bounds):
+    GenericGroupSIS(std::make_shared<const BipartiteNetwork>(edge_list),
+            recovery_rate, infection_rate, rate_bounds)
+{
+}
+
+//constructor of the class from a shared network
+template <class RatePolicy>
+GenericGroupSIS<RatePolicy>::GenericGroupSIS(SharedNetwork network,
+        double recovery_rate, const RatePolicy& infection_rate,
+        const std::pair<double,double>& rate_bounds):
+    GenericGroupSIS(network, recovery_rate, infection_rate, rate_bounds, true)
+{
+}
+
+//constructor of the class from a shared network, with a fixed range of
+//rates unless adaptive
+template <class RatePolicy>
+GenericGroupSIS<RatePolicy>::GenericGroupSIS(SharedNetwork network,
+        double recovery_rate, const RatePolicy& infection_rate,
+        const std::pair<double,double>& rate_bounds, bool adaptive):
+    Contagion(network, recovery_rate, rate_bounds, adaptive),
+    infection_rate_(infection_rate)
+{
+}
+
+//constructor of the class from an edge list, with exact rate bounds
+template <class RatePolicy>
+GenericGroupSIS<RatePolicy>::GenericGroupSIS(const EdgeList& edge_list,
+        double recovery_rate, const RatePolicy& infection_rate):
+    GenericGroupSIS(std::make_shared<const BipartiteNetwork>(edge_list),
+            recovery_rate, infection_rate)
+{
+}
+
+//constructor of the class from a shared network, with exact rate bounds
+template <class RatePolicy>
+GenericGroupSIS<RatePolicy>::GenericGroupSIS(SharedNetwork network,
+        double recovery_rate, const RatePolicy& infection_rate):
+    GenericGroupSIS(network, recovery_rate, infection_rate,
+            rate_bounds(*Contagion::checked_network(network), recovery_rate,
+                infection_rate), false)
+{
+}
+
+//SIS processes with the infection kernels of GroupRate.hpp
+typedef GenericGroupSIS<LinearRate> LinearGroupSIS;
+typedef GenericGroupSIS<QuadraticRate> QuadraticGroupSIS;
+typedef GenericGroupSIS<ThresholdRate> ThresholdGroupSIS;
+
+}//end of namespace schon
+
+#endif /* GENERICGROUPSIS_HPP_ */
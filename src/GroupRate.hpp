@@ -0,0 +1,211 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Guillaume St-Onge
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef GROUPRATE_HPP_
+#define GROUPRATE_HPP_
+
+#include "BipartiteNetwork.hpp"
+#include <functional>
+#include <vector>
+#include <utility>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+
+namespace schon
+{//start of namespace schon
+
+//Rate policies for GenericGroupSIS: rate(n,i) is the infection rate of a
+//group of size n with i infected nodes. Policies are called on every group
+//update, so the closed forms are kept inline.
+
+//scale*(n-i)*i^Shape for an integer shape known at compile time, the power
+//being unrolled into products
+template <unsigned int Shape>
+class IntegerPowerlawRate
+{
+public:
+    //Constructor
+    IntegerPowerlawRate(double scale) : scale_(scale) {}
+
+    //Accessors
+    double operator()(std::size_t n, std::size_t i) const
+        {return scale_*(n-i)*power<Shape>(i);}
+
+private:
+    //Members
+    double scale_;
+
+    //utility function
+    template <unsigned int Exponent>
+    static double power(double x)
+        {if constexpr (Exponent == 0) {return 1.;}
+            else {return x*power<Exponent-1>(x);}}
+};
+
+typedef IntegerPowerlawRate<1> LinearRate;
+typedef IntegerPowerlawRate<2> QuadraticRate;
+
+//arbitrary function of n and i, optionally tabulated; a power law of integer
+//shape 1 or 2 is instead inlined as an IntegerPowerlawRate
+class FunctionRate
+{
+public:
+    //Constructor
+    FunctionRate(const std::function<double(std::size_t,std::size_t)>&
+            function) : function_(function), integer_shape_(0), scale_(0),
+        tabulated_(false), table_(), offset_() {}
+    //scale*(n-i)*i^shape
+    static FunctionRate powerlaw(double scale, double shape);
+
+    //Accessors
+    double operator()(std::size_t n, std::size_t i) const
+    {
+        switch (integer_shape_)
+        {
+            case 1: return LinearRate(scale_)(n,i);
+            case 2: return QuadraticRate(scale_)(n,i);
+            default: return tabulated_ ? table_[offset_[n] + i]
+                     : function_(n,i);
+        }
+    }
+    bool is_integer_powerlaw() const
+        {return integer_shape_ != 0;}
+    bool is_tabulated() const
+        {return tabulated_;}
+    std::size_t footprint() const //in bytes
+        {return table_.capacity()*sizeof(double)
+            + offset_.capacity()*sizeof(std::size_t);}
+
+    //Mutators
+    //evaluate the function once for the group sizes present in the network
+    //and all number of infected, the rate (n,i) being table_[offset_[n] + i]
+    void tabulate(const BipartiteNetwork& network)
+    {
+        if (integer_shape_ != 0)
+        {
+            return; //the inlined power law needs no table
+        }
+        std::size_t max_size = network.max_group_size();
+        std::vector<bool> present(max_size+1, false);
+        for (Group group : network.groups())
+        {
+            present[network.group_size(group)] = true;
+        }
+        table_.clear();
+        offset_ = std::vector<std::size_t>(max_size+1, 0);
+        for (std::size_t n = 0; n <= max_size; n++)
+        {
+            if (present[n])
+            {
+                offset_[n] = table_.size();
+                for (std::size_t i = 0; i <= n; i++)
+                {
+                    table_.push_back(function_(n,i));
+                }
+            }
+        }
+        table_.shrink_to_fit();
+        tabulated_ = true;
+    }
+
+private:
+    //Members
+    std::function<double(std::size_t,std::size_t)> function_;
+    unsigned int integer_shape_; //0 if the rate is not an inlined power law
+    double scale_;
+    bool tabulated_;
+    std::vector<double> table_;
+    std::vector<std::size_t> offset_;
+};
+
+inline FunctionRate FunctionRate::powerlaw(double scale, double shape)
+{
+    FunctionRate rate([=](std::size_t n,std::size_t i) -> double
+            {return scale*(n-i)*pow(i,shape);});
+    if (shape == 1 or shape == 2)
+    {
+        rate.integer_shape_ = shape;
+        rate.scale_ = scale;
+    }
+    return rate;
+}
+
+
+//scale*(n-i) if at least threshold nodes are infected, 0 otherwise
+class ThresholdRate
+{
+public:
+    //Constructor
+    ThresholdRate(double scale, std::size_t threshold) : scale_(scale),
+        threshold_(threshold) {}
+
+    //Accessors
+    double operator()(std::size_t n, std::size_t i) const
+        {return i >= threshold_ ? scale_*(n-i) : 0.;}
+
+private:
+    //Members
+    double scale_;
+    std::size_t threshold_;
+};
+
+//smallest and largest positive rates among the infection rates of the groups
+//in all their states and the recovery rate, to be used as exact bounds for
+//the event set
+template <class RatePolicy>
+std::pair<double,double> rate_bounds(const BipartiteNetwork& network,
+        double recovery_rate, const RatePolicy& infection_rate)
+{
+    double min = std::numeric_limits<double>::infinity();
+    double max = 0;
+    auto include = [&](double rate)
+        {if (rate > 0) {min = std::min(min,rate); max = std::max(max,rate);}};
+    include(recovery_rate);
+    std::vector<bool> present(network.max_group_size()+1, false);
+    for (Group group : network.groups())
+    {
+        present[network.group_size(group)] = true;
+    }
+    for (std::size_t n = 0; n < present.size(); n++)
+    {
+        if (present[n])
+        {
+            for (std::size_t i = 0; i <= n; i++)
+            {
+                include(infection_rate(n,i));
+            }
+        }
+    }
+    if (max == 0)
+    {
+        return std::make_pair(1.,1.); //no positive rate, any bounds will do
+    }
+    return std::make_pair(min,max);
+}
+
+}//end of namespace schon
+
+#endif /* GROUPRATE_HPP_ */
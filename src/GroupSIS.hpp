@@ -25,51 +25,65 @@
 #ifndef GROUPSIS_HPP_
 #define GROUPSIS_HPP_
 
-#include "SamplableSet/SamplableSet.hpp"
-#include "BaseContagion.hpp"
+#include "GenericGroupSIS.hpp"
 #include <functional>
 
 namespace schon
 {//start of namespace schon
 
 
-//class to simulate SIS process on networks
-class GroupSIS : public BaseContagion
+//class to simulate SIS process on networks, with an arbitrary infection rate
+//function of the group size and the number of infected nodes
+class GroupSIS : public GenericGroupSIS<FunctionRate>
 {
 public:
     //Constructor
+    //the rate bounds are an initial guess, extended if needed
     GroupSIS(const EdgeList& edge_list, double recovery_rate,
             const std::function<double(std::size_t,std::size_t)>& infection_rate,
-            const std::pair<double,double>& rate_bounds);
+            const std::pair<double,double>& rate_bounds,
+            bool tabulate = false);
+    GroupSIS(SharedNetwork network, double recovery_rate,
+            const std::function<double(std::size_t,std::size_t)>& infection_rate,
+            const std::pair<double,double>& rate_bounds,
+            bool tabulate = false);
+    //the rate bounds are obtained from the rates of all group states
+    GroupSIS(const EdgeList& edge_list, double recovery_rate,
+            const std::function<double(std::size_t,std::size_t)>& infection_rate,
+            bool tabulate = false);
+    GroupSIS(SharedNetwork network, double recovery_rate,
+            const std::function<double(std::size_t,std::size_t)>& infection_rate,
+            bool tabulate = false);
 
     //Accessors
-    double get_lifetime() const
-        {return event_set_.size() == 0 ?
-            std::numeric_limits<double>::infinity() :
-            1/event_set_.total_weight();}
+    bool is_tabulated() const
+        {return infection_rate_.is_tabulated();}
+    //true if the infection rate function is called on each event, instead
+    //of being looked up in a table or computed inline
+    bool calls_infection_rate() const
+        {return not (infection_rate_.is_tabulated()
+                or infection_rate_.is_integer_powerlaw());}
+    std::size_t rate_table_footprint() const //in bytes
+        {return infection_rate_.footprint();}
 
     //Mutators
-    void clear();
+    //evaluate the infection rate once for all states of the groups, so that
+    //it is afterward looked up in a table instead of called on each event
+    void tabulate_infection_rate()
+        {infection_rate_.tabulate(*network_);}
 
 protected:
-    //Members
-    double recovery_rate_;
-    std::function<double(std::size_t,std::size_t)> infection_rate_;
-    sset::SamplableSet<Event> event_set_;
-
-    //utility functions
-    inline double get_recovery_rate(Group group) const
-        {return recovery_rate_;}
-    inline double get_infection_rate(Group group) const
-        {return infection_rate_(network_.group_size(group),
-                group_state_vector_[group][I].size());}
-    inline void update_group_rate(Group group, Node node,
-            NodeState previous_state, NodeState new_state);
-
-    inline void infect(Node node);
-    inline void recover(Node node);
-    inline void next_event();
+    //Constructor from a rate policy already built, see PowerlawGroupSIS
+    GroupSIS(SharedNetwork network, double recovery_rate,
+            const FunctionRate& infection_rate,
+            const std::pair<double,double>& rate_bounds, bool tabulate);
+    GroupSIS(SharedNetwork network, double recovery_rate,
+            const FunctionRate& infection_rate, bool tabulate);
 
+private:
+    //utility function
+    static FunctionRate prepared_rate(const SharedNetwork& network,
+            const FunctionRate& infection_rate, bool tabulate);
 };
 
 }//end of namespace schon
@@ -25,6 +25,7 @@
 #include "HeterogeneousExposure.hpp"
 #include <optional>
 #include <utility>
+#include <memory>
 #include <iostream>
 #include <exception>
 #include <cmath>
@@ -35,10 +36,18 @@ using namespace std;
 namespace schon
 {//start of namespace schon
 
-//constructor of the class
+//constructor of the class from an edge list
 HeterogeneousExposure::HeterogeneousExposure(const EdgeList& edge_list, double recovery_probability,
         double alpha, double T, double beta, double K):
-    BaseContagion(edge_list),
+    HeterogeneousExposure(make_shared<const BipartiteNetwork>(edge_list),
+            recovery_probability, alpha, T, beta, K)
+{
+}
+
+//constructor of the class from a shared network
+HeterogeneousExposure::HeterogeneousExposure(SharedNetwork network, double recovery_probability,
+        double alpha, double T, double beta, double K):
+    ContagionEngine<HeterogeneousExposure>(network),
     recovery_probability_(recovery_probability),
     recovery_propensity_(-log(1-recovery_probability)),
     recovery_event_set_(1.,1.),
@@ -48,24 +57,7 @@ HeterogeneousExposure::HeterogeneousExposure(const EdgeList& edge_list, double r
     beta_(beta),
     K_(K)
 {
-}
-
-//update the group state
-inline void HeterogeneousExposure::update_group_state(Group group, Node node,
-        NodeState previous_state, NodeState new_state)
-{
-    GroupState & group_state = group_state_vector_[group];
-    size_t position = group_state_position_vector_[group][node];
-    //if node not in the back, put node in the back position
-    swap(group_state[previous_state][position],
-            group_state[previous_state].back());
-    //also update the position of the node in the back
-    Node back_node = group_state[previous_state][position];
-    group_state_position_vector_[group][back_node] = position;
-    //put node in new group state
-    group_state[previous_state].pop_back();
-    group_state_position_vector_[group][node] = group_state[new_state].size();
-    group_state[new_state].push_back(node);
+    recovery_event_set_.reserve(network_->size());
 }
 
 //infect a node
@@ -75,9 +67,11 @@ inline void HeterogeneousExposure::infect(Node node)
     {
         node_state_vector_[node] = I;
         infected_node_set_.insert(node);
-        for (Group group : network_.adjacent_groups(node))
+        Span<Group> groups = network_->adjacent_groups(node);
+        Span<Membership> memberships = network_->memberships(node);
+        for (size_t i = 0; i < groups.size(); i++)
         {
-            update_group_state(group,node,S,I);
+            update_group_state(groups[i],memberships[i],S,I);
         }
         //create a recovery event for the node
         recovery_event_set_.insert(node, 1.);
@@ -95,9 +89,11 @@ inline void HeterogeneousExposure::recover(Node node)
     {
         node_state_vector_[node] = S;
         infected_node_set_.erase(node);
-        for (Group group : network_.adjacent_groups(node))
+        Span<Group> groups = network_->adjacent_groups(node);
+        Span<Membership> memberships = network_->memberships(node);
+        for (size_t i = 0; i < groups.size(); i++)
         {
-            update_group_state(group,node,I,S);
+            update_group_state(groups[i],memberships[i],I,S);
         }
         //erase the recovery event for the node
         recovery_event_set_.erase(node);
@@ -112,7 +108,8 @@ inline void HeterogeneousExposure::recover(Node node)
 //advance the process to the next step by performing infection/recovery
 inline void HeterogeneousExposure::next_event()
 {
-    current_time_ = last_event_time_ + get_lifetime();
+    current_time_ = last_event_time_
+        + HeterogeneousExposure::get_lifetime();
     //get the number of recoveries and assign them
     poisson_dist_ = poisson_distribution<int>(
             recovery_propensity_*recovery_event_set_.size());
@@ -121,22 +118,22 @@ inline void HeterogeneousExposure::next_event()
     for (int i = 0; i < nb_rec; i++)
     {
         pair<Node,double> node_weight_pair =
-            (recovery_event_set_.sample()).value();
+            (recovery_event_set_.sample_ext_RNG(gen_)).value();
         new_susceptible.insert(node_weight_pair.first);
     }
     //get the infections
     double tau, kappa, rho;
     double n,i;
     unordered_set<Node> new_infected;
-    for (Group group = 0; group < network_.number_of_groups(); group++)
+    for (Group group = 0; group < network_->number_of_groups(); group++)
     {
-        GroupState & group_state = group_state_vector_[group];
-        n = network_.group_size(group);
-        i = group_state[I].size();
+        n = network_->group_size(group);
+        i = group_state_vector_[group][I];
         rho = i/(n-1);
         //for all susceptible, check for infections
-        for (Node node : group_state[S])
+        for (Membership membership : group_state_members(group, S))
         {
+            Node node = network_->member(membership);
             tau = get_participation_time();
             kappa = get_dose(tau,rho);
             if (kappa > K_)
@@ -149,16 +146,33 @@ inline void HeterogeneousExposure::next_event()
     //perform recovery and infections
     for (Node node : new_susceptible)
     {
-        recover(node);
+        HeterogeneousExposure::recover(node);
     }
     for (Node node : new_infected)
     {
-        infect(node);
+        HeterogeneousExposure::infect(node);
     }
     last_event_time_ = current_time_;
 }
 
 
+//recreate the recovery events of all infected nodes
+//overload BaseContagion
+void HeterogeneousExposure::rebuild_event_set()
+{
+    vector<pair<Node,double>> recovery_vector;
+    recovery_vector.reserve(infected_node_set_.size());
+    for (Node node = 0; node < network_->size(); node++)
+    {
+        if (node_state_vector_[node] == I)
+        {
+            recovery_vector.push_back(make_pair(node,1.));
+        }
+    }
+    recovery_event_set_.assign(recovery_vector.begin(),
+            recovery_vector.end());
+}
+
 //clear the state; as if all node became susceptible at this time
 //clear all measures as well
 //overload BaseContagion
@@ -25,19 +25,21 @@
 #ifndef HETEROGENEOUSEXPOSURE_HPP_
 #define HETEROGENEOUSEXPOSURE_HPP_
 
-#include "BaseContagion.hpp"
+#include "ContagionEngine.hpp"
 
 namespace schon
 {//start of namespace schon
 
 
 //class to simulate SIS process on networks
-class HeterogeneousExposure : public BaseContagion
+class HeterogeneousExposure : public ContagionEngine<HeterogeneousExposure>
 {
 public:
     //Constructor
     HeterogeneousExposure(const EdgeList& edge_list, double recovery_probability,
             double alpha, double T, double beta, double K);
+    HeterogeneousExposure(SharedNetwork network, double recovery_probability,
+            double alpha, double T, double beta, double K);
 
     //Accessors
     double get_lifetime() const
@@ -51,7 +53,7 @@ protected:
     //Members
     double recovery_probability_;
     double recovery_propensity_;
-    sset::SamplableSet<Node> recovery_event_set_;
+    sset::DenseSamplableSet<Node> recovery_event_set_;
     std::poisson_distribution<int> poisson_dist_;
     double alpha_;
     double T_;
@@ -71,12 +73,12 @@ protected:
         return pow(1/(1-r*(1-pow(T_,-alpha_))), 1./alpha_);
     }
 
-    inline void update_group_state(Group group, Node node,
-            NodeState previous_state, NodeState new_state);
-
     inline void infect(Node node);
     inline void recover(Node node);
     inline void next_event();
+    //the evolution loop calls the events directly
+    friend class ContagionEngine<HeterogeneousExposure>;
+    void rebuild_event_set();
 };
 
 }//end of namespace schon
@@ -49,4 +49,12 @@ void InfectiousSet::measure(
     infectious_set_vector_.push_back(ptr->get_infected_node_set());
 }
 
+//append the results of another measure
+void InfectiousSet::merge(const Measure& measure)
+{
+    const InfectiousSet& other = dynamic_cast<const InfectiousSet&>(measure);
+    infectious_set_vector_.insert(infectious_set_vector_.end(),
+            other.infectious_set_vector_.begin(), other.infectious_set_vector_.end());
+}
+
 }//end of namespace schon
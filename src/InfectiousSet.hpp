@@ -45,6 +45,7 @@ public:
 
     //Mutators
     void measure(ContagionProcess const * const ptr);
+    void merge(const Measure& measure);
     void clear()
         {infectious_set_vector_.clear();}
 
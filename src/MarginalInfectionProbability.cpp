@@ -23,6 +23,7 @@
  */
 
 #include "MarginalInfectionProbability.hpp"
+#include <stdexcept>
 
 using namespace std;
 
@@ -39,16 +40,20 @@ MarginalInfectionProbability::MarginalInfectionProbability(
 //return the marginal probability of infection for each node
 vector<double> MarginalInfectionProbability::get_result() const
 {
-    vector<double> marginal_vector(weight_vector_);
-    if (count_ > 0)
+    vector<double> marginal_vector(weight_vector_.size());
+    get_result(marginal_vector.data());
+    return marginal_vector;
+}
+
+//write the marginal probability of infection for each node in an array of
+//size() elements
+void MarginalInfectionProbability::get_result(double* marginal_array) const
+{
+    double normalization = (count_ > 0) ? count_ : 1.;
+    for (size_t node = 0; node < weight_vector_.size(); node++)
     {
-        for (auto iter = marginal_vector.begin();
-                iter != marginal_vector.end(); iter++)
-        {
-            *iter /= count_;
-        }
+        marginal_array[node] = weight_vector_[node]/normalization;
     }
-    return marginal_vector;
 }
 
 //perform a measure on the contagion process
@@ -65,4 +70,21 @@ void MarginalInfectionProbability::measure(
     count_ += 1;
 }
 
+//add the weights and the count of another measure
+void MarginalInfectionProbability::merge(const Measure& measure)
+{
+    const MarginalInfectionProbability& other =
+        dynamic_cast<const MarginalInfectionProbability&>(measure);
+    if (other.weight_vector_.size() != weight_vector_.size())
+    {
+        throw invalid_argument(
+                "Marginal infection probability: the networks differ in size");
+    }
+    for (size_t node = 0; node < weight_vector_.size(); node++)
+    {
+        weight_vector_[node] += other.weight_vector_[node];
+    }
+    count_ += other.count_;
+}
+
 }//end of namespace schon
@@ -38,11 +38,15 @@ public:
 
     //Acessors
     std::vector<double> get_result() const;
+    void get_result(double* marginal_array) const;
+    std::size_t size() const
+        {return weight_vector_.size();}
     const std::string& get_name() const
         {return name_;}
 
     //Mutators
     void measure(ContagionProcess const * const ptr);
+    void merge(const Measure& measure);
     void clear()
         {count_ = 0; weight_vector_ = std::vector<double>(weight_vector_.size(), 0.);}
 
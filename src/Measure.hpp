@@ -42,6 +42,8 @@ public:
     virtual void measure(ContagionProcess const * const pointer) = 0;
     virtual const std::string& get_name() const = 0;
     virtual void clear() = 0;
+    //add the result of another measure of the same type to this one
+    virtual void merge(const Measure& measure) = 0;
 };
 
 }//end of namespace schon
@@ -30,25 +30,59 @@
 namespace schon
 {//start of namespace schon
 
-//class to simulate SIS process on networks
+//class to simulate SIS process on networks, with infection rate
+//scale*(n-i)*i^shape; the integer shapes 1 and 2 are inlined as in
+//LinearGroupSIS and QuadraticGroupSIS, the other shapes are tabulated
 class PowerlawGroupSIS : public GroupSIS
 {
 public:
     //Constructor
+    //the rate bounds are an initial guess, extended if needed
     PowerlawGroupSIS(const EdgeList& edge_list, double recovery_rate,
             double scale_infection, double shape_infection,
             const std::pair<double,double>& rate_bounds);
+    PowerlawGroupSIS(SharedNetwork network, double recovery_rate,
+            double scale_infection, double shape_infection,
+            const std::pair<double,double>& rate_bounds);
+    //the rate bounds are obtained from the rates of all group states
+    PowerlawGroupSIS(const EdgeList& edge_list, double recovery_rate,
+            double scale_infection, double shape_infection);
+    PowerlawGroupSIS(SharedNetwork network, double recovery_rate,
+            double scale_infection, double shape_infection);
 };
 
 //constructor definiton
-PowerlawGroupSIS::PowerlawGroupSIS(const EdgeList& edge_list, double recovery_rate,
-            double scale_infection, double shape_infection,
-            const std::pair<double,double>& rate_bounds) : GroupSIS(
-                edge_list, recovery_rate, NULL, rate_bounds)
+inline PowerlawGroupSIS::PowerlawGroupSIS(const EdgeList& edge_list,
+            double recovery_rate, double scale_infection,
+            double shape_infection, const std::pair<double,double>& rate_bounds):
+    PowerlawGroupSIS(std::make_shared<const BipartiteNetwork>(edge_list),
+            recovery_rate, scale_infection, shape_infection, rate_bounds)
+{
+}
+
+inline PowerlawGroupSIS::PowerlawGroupSIS(SharedNetwork network,
+            double recovery_rate, double scale_infection,
+            double shape_infection, const std::pair<double,double>& rate_bounds):
+    GroupSIS(network, recovery_rate,
+            FunctionRate::powerlaw(scale_infection, shape_infection),
+            rate_bounds, true)
+{
+}
+
+inline PowerlawGroupSIS::PowerlawGroupSIS(const EdgeList& edge_list,
+            double recovery_rate, double scale_infection,
+            double shape_infection):
+    PowerlawGroupSIS(std::make_shared<const BipartiteNetwork>(edge_list),
+            recovery_rate, scale_infection, shape_infection)
+{
+}
+
+inline PowerlawGroupSIS::PowerlawGroupSIS(SharedNetwork network,
+            double recovery_rate, double scale_infection,
+            double shape_infection):
+    GroupSIS(network, recovery_rate,
+            FunctionRate::powerlaw(scale_infection, shape_infection), true)
 {
-    //define the recovery/infection rates
-    infection_rate_ = [=](std::size_t n,std::size_t i) -> double
-        {return scale_infection*(n-i)*pow(i,shape_infection);};
 }
 
 }//end of namespace schon
@@ -32,14 +32,27 @@ namespace schon
 
 //constructor
 Prevalence::Prevalence(size_t network_size): name_("prevalence"),
-    network_size_(network_size), prevalence_vector_()
+    network_size_(network_size),
+    prevalence_vector_()
 {
 }
 
 //return the prevalence
 vector<double> Prevalence::get_result() const
 {
-    return prevalence_vector_;
+    return vector<double>(prevalence_vector_.begin(),
+            prevalence_vector_.end());
+}
+
+//return the prevalence measured from a certain index, to fetch incrementally
+vector<double> Prevalence::get_result_since(size_t offset) const
+{
+    if (offset >= prevalence_vector_.size())
+    {
+        return vector<double>();
+    }
+    return vector<double>(prevalence_vector_.begin() + offset,
+            prevalence_vector_.end());
 }
 
 //perform a measure on the contagion process
@@ -50,4 +63,11 @@ void Prevalence::measure(
     prevalence_vector_.push_back(I);
 }
 
+//append the results of another measure
+void Prevalence::merge(const Measure& measure)
+{
+    const Prevalence& other = dynamic_cast<const Prevalence&>(measure);
+    prevalence_vector_.append(other.prevalence_vector_);
+}
+
 }//end of namespace schon
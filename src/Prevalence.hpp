@@ -26,7 +26,9 @@
 #define PREVALENCE_HPP_
 
 #include "Measure.hpp"
+#include "ResultBuffer.hpp"
 #include <vector>
+#include <memory>
 
 namespace schon
 {//start of namespace schon
@@ -39,11 +41,16 @@ public:
 
     //Acessors
     std::vector<double> get_result() const;
+    std::vector<double> get_result_since(std::size_t offset) const;
+    //snapshot of the result, left untouched by later measures
+    ResultBuffer::Snapshot get_shared_result() const
+        {return prevalence_vector_.snapshot();}
     const std::string& get_name() const
         {return name_;}
 
     //Mutators
     void measure(ContagionProcess const * const ptr);
+    void merge(const Measure& measure);
     void clear()
         {prevalence_vector_.clear();}
 
@@ -51,7 +58,7 @@ private:
     //Members
     const std::string name_;
     const std::size_t network_size_;
-    std::vector<double> prevalence_vector_;
+    ResultBuffer prevalence_vector_;
 };
 
 }//end of namespace schon
@@ -0,0 +1,105 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 Guillaume St-Onge
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef RESULTBUFFER_HPP_
+#define RESULTBUFFER_HPP_
+
+#include "BipartiteNetwork.hpp"
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+namespace schon
+{//start of namespace schon
+
+//values appended by a measure, shared by the snapshots of the values already
+//measured: the buffer only grows in place, within its capacity, so that the
+//values of a snapshot are never moved nor modified, and it continues in a
+//larger buffer when a snapshot refers to a full one
+class ResultBuffer
+{
+public:
+    //values measured up to a point, owning the memory it refers to
+    struct Snapshot
+    {
+        std::shared_ptr<const std::vector<double>> owner;
+        Span<double> values;
+    };
+
+    //Constructor
+    ResultBuffer() : buffer_(std::make_shared<std::vector<double>>()) {}
+
+    //Accessors
+    std::size_t size() const
+        {return buffer_->size();}
+    const double* begin() const
+        {return buffer_->data();}
+    const double* end() const
+        {return buffer_->data() + buffer_->size();}
+    Snapshot snapshot() const
+        {return Snapshot{buffer_, Span<double>(begin(), end())};}
+
+    //Mutators
+    void push_back(double value)
+        {reserve_for(1); buffer_->push_back(value);}
+    void append(const ResultBuffer& other)
+    {
+        if (&other == this)
+        {
+            //the values inserted must not be in the buffer they go in
+            std::vector<double> values(begin(), end());
+            reserve_for(values.size());
+            buffer_->insert(buffer_->end(), values.begin(), values.end());
+            return;
+        }
+        reserve_for(other.size());
+        buffer_->insert(buffer_->end(), other.begin(), other.end());
+    }
+    void clear()
+        {buffer_ = std::make_shared<std::vector<double>>();}
+
+private:
+    //Members
+    std::shared_ptr<std::vector<double>> buffer_;
+
+    //utility function
+    //make room for new values without reallocating a shared buffer
+    void reserve_for(std::size_t number_of_values)
+    {
+        std::size_t size = buffer_->size();
+        if (size + number_of_values > buffer_->capacity()
+                and buffer_.use_count() > 1)
+        {
+            auto buffer = std::make_shared<std::vector<double>>();
+            buffer->reserve(std::max(2*buffer_->capacity(),
+                        size + number_of_values));
+            buffer->insert(buffer->end(), buffer_->begin(), buffer_->end());
+            buffer_ = buffer;
+        }
+    }
+};
+
+}//end of namespace schon
+
+#endif /* RESULTBUFFER_HPP_ */
@@ -0,0 +1,75 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Guillaume St-Onge
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "FlatBinaryTree.hpp"
+#include <algorithm>
+
+using namespace std;
+
+namespace sset
+{//start of namespace sset
+
+
+//Default constructor of the class FlatBinaryTree
+FlatBinaryTree::FlatBinaryTree() :
+    n_leaves_(0),
+    capacity_(1),
+    tree_(2, 0.)
+{
+}
+
+//Constructor of the class FlatBinaryTree with specified leaves number
+FlatBinaryTree::FlatBinaryTree(unsigned int n_leaves) :
+    n_leaves_(n_leaves),
+    capacity_(1),
+    tree_()
+{
+    while (capacity_ < n_leaves_)
+    {
+        capacity_ <<= 1;
+    }
+    tree_ = vector<double>(2*capacity_, 0.);
+}
+
+//set the values of the first leaves, the others being 0, then compute the
+//internal nodes from the bottom up
+void FlatBinaryTree::assign(const vector<double>& leaf_value_vector)
+{
+    fill(tree_.begin(), tree_.end(), 0.);
+    copy(leaf_value_vector.begin(), leaf_value_vector.end(),
+            tree_.begin() + capacity_);
+    for (size_t index = capacity_-1; index > 0; index--)
+    {
+        tree_[index] = tree_[2*index] + tree_[2*index+1];
+    }
+}
+
+//remove value for all nodes
+void FlatBinaryTree::clear()
+{
+    fill(tree_.begin(), tree_.end(), 0.);
+}
+
+}//end of namespace sset
@@ -0,0 +1,115 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Guillaume St-Onge
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef FLATBINARYTREE_HPP
+#define FLATBINARYTREE_HPP
+
+#include <vector>
+#include <cstddef>
+
+namespace sset
+{//start of namespace sset
+
+//Define new types
+typedef unsigned int LeafIndex;
+
+/*
+ * Binary tree to udpate dynamically a cumulative distribution, stored as an
+ * implicit heap in a contiguous array. The root is at index 1, the children
+ * of node i are at 2i and 2i+1, and the leaves occupy [capacity, 2*capacity),
+ * where capacity is the number of leaves rounded up to a power of two.
+ */
+class FlatBinaryTree
+{
+public:
+    //Constructor
+    FlatBinaryTree();
+    FlatBinaryTree(unsigned int n_leaves);
+
+    //Accessors
+    std::size_t number_of_leaves() const
+        {return n_leaves_;}
+    double get_value() const
+        {return tree_[1];}
+    double get_leaf_value(LeafIndex leaf_index) const
+        {return tree_[leaf_index + capacity_];}
+    inline LeafIndex get_leaf_index(double r) const;
+
+    //Mutators
+    inline void update_value(LeafIndex leaf_index, double variation);
+    inline void set_value(LeafIndex leaf_index, double value);
+    void assign(const std::vector<double>& leaf_value_vector);
+    void clear();
+
+private:
+    //Members
+    std::size_t n_leaves_;
+    std::size_t capacity_;
+    std::vector<double> tree_;
+};
+
+//Get the leaf index associated to the cumulative fraction r
+inline LeafIndex FlatBinaryTree::get_leaf_index(double r) const
+{
+    double cumul = r*tree_[1];
+    std::size_t index = 1;
+    while (index < capacity_)
+    {
+        index <<= 1; //left child
+        //never move toward an empty subtree (e.g. padding leaves), even
+        //for a cumulative fraction of 0
+        if (cumul >= tree_[index] and tree_[index+1] > 0)
+        {
+            cumul -= tree_[index];
+            index += 1; //right child
+        }
+    }
+    return index - capacity_;
+}
+
+//update value for the leaf and parents
+inline void FlatBinaryTree::update_value(LeafIndex leaf_index, double variation)
+{
+    for (std::size_t index = leaf_index + capacity_; index > 0; index >>= 1)
+    {
+        tree_[index] += variation;
+    }
+}
+
+//set the value of a leaf exactly, the parents being recomputed from their
+//children such that they do not keep the rounding errors of the variations
+inline void FlatBinaryTree::set_value(LeafIndex leaf_index, double value)
+{
+    std::size_t index = leaf_index + capacity_;
+    tree_[index] = value;
+    for (index >>= 1; index > 0; index >>= 1)
+    {
+        tree_[index] = tree_[2*index] + tree_[2*index+1];
+    }
+}
+
+}//end of namespace sset
+
+#endif /* FLATBINARYTREE_HPP */
@@ -35,15 +35,18 @@ namespace sset
 //Default constructor
 HashPropensity::HashPropensity(double propensity_min, double propensity_max) :
     propensity_min_(propensity_min), propensity_max_(propensity_max),
-    power_of_two_(false)
+    power_of_two_(false), min_exponent_(0), min_mantissa_(0)
 {
-    if (propensity_min == 0. or isinf(propensity_max))
+    if (not (propensity_min > 0.) or isinf(propensity_max))
     {
         throw invalid_argument("Invalid minimal or maximal weight");
     }
-    if (floor(log2(propensity_max/propensity_min)) ==
-        ceil(log2(propensity_max/propensity_min)) and
-        propensity_max != propensity_min)
+    decompose(propensity_min_, min_exponent_, min_mantissa_);
+    //max/min is a power of two if their mantissas are equal
+    int max_exponent;
+    uint64_t max_mantissa;
+    decompose(propensity_max_, max_exponent, max_mantissa);
+    if (max_mantissa == min_mantissa_ and propensity_max != propensity_min)
     {
         power_of_two_ = true;
     }
@@ -53,19 +56,10 @@ HashPropensity::HashPropensity(double propensity_min, double propensity_max) :
 HashPropensity::HashPropensity(const HashPropensity& hash_object) :
     propensity_min_(hash_object.propensity_min_),
     propensity_max_(hash_object.propensity_max_),
-    power_of_two_(hash_object.power_of_two_)
+    power_of_two_(hash_object.power_of_two_),
+    min_exponent_(hash_object.min_exponent_),
+    min_mantissa_(hash_object.min_mantissa_)
 {
 }
 
-//Call operator
-size_t HashPropensity::operator()(double propensity) const
-{
-    size_t index = floor(log2(propensity/propensity_min_));
-    if (power_of_two_ and propensity == propensity_max_)
-    {
-        index -=1 ;
-    }
-    return index;
-}
-
 }//end of namespace sset
@@ -26,6 +26,8 @@
 #define HASHPROPENSITY_HPP_
 
 #include <cstdlib>
+#include <cstdint>
+#include <cstring>
 
 namespace sset
 {//start of namespace sset
@@ -39,16 +41,58 @@ public:
     HashPropensity(double propensity_min, double propensity_max);
     HashPropensity(const HashPropensity& hash_object);
 
-    //Call operator definition
-    std::size_t operator()(double propensity) const;
+    //Call operator definition: the exponent floor(log2(propensity/min)) of
+    //the propensity group, negative for propensities below the minimum
+    inline int operator()(double propensity) const;
 
 private:
     //Members
     double propensity_min_;
     double propensity_max_;
     bool power_of_two_;
+    int min_exponent_;
+    std::uint64_t min_mantissa_;
+
+    //utility functions
+    static constexpr std::uint64_t MANTISSA_MASK = (std::uint64_t(1) << 52) - 1;
+    inline static void decompose(double x, int& exponent,
+            std::uint64_t& mantissa);
 };
 
+//biased exponent and mantissa bits of the IEEE-754 representation of a
+//positive finite double, subnormals being normalized by a factor 2^64
+inline void HashPropensity::decompose(double x, int& exponent,
+        std::uint64_t& mantissa)
+{
+    std::uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    exponent = int(bits >> 52);
+    if (exponent == 0)
+    {
+        x *= 0x1p64;
+        std::memcpy(&bits, &x, sizeof(bits));
+        exponent = int(bits >> 52) - 64;
+    }
+    mantissa = bits & MANTISSA_MASK;
+}
+
+//Call operator: with propensity = (1+f)*2^e and min = (1+g)*2^d, the group is
+//e - d, minus one if f < g; this is exact, without division nor logarithm
+inline int HashPropensity::operator()(double propensity) const
+{
+    int exponent;
+    std::uint64_t mantissa;
+    decompose(propensity, exponent, mantissa);
+    int index = exponent - min_exponent_ - (mantissa < min_mantissa_);
+    //the maximal propensity closes the last group when max/min is a power
+    //of two
+    if (power_of_two_ and propensity == propensity_max_)
+    {
+        index -= 1;
+    }
+    return index;
+}
+
 }//end of namespace sset
 
 #endif /* HASHPROPENSITY_HPP_ */
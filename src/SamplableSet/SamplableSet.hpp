@@ -26,15 +26,21 @@
 #define SAMPLABLESET_HPP_
 
 #include "HashPropensity.hpp"
-#include "BinaryTree.hpp"
+#include "FlatBinaryTree.hpp"
 #include "pcg-cpp/include/pcg_random.hpp"
 #include <utility>
+#include <unordered_map>
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
 #include <random>
 #include <iostream>
 #include <optional>
 #include <stdio.h>
 #include <time.h>
 #include <stdexcept>
+#include <type_traits>
 
 namespace sset
 {//start of namespace sset
@@ -44,6 +50,65 @@ typedef unsigned int InGroupIndex;
 typedef std::pair<GroupIndex, InGroupIndex> SSetPosition; //Set element Id
 typedef pcg32 RNGType;
 
+//Bounds checking of the internal accesses on the sampling path, enabled by
+//defining SAMPLABLESET_CHECKED (see the CMake option of the same name)
+#ifdef SAMPLABLESET_CHECKED
+constexpr bool CHECKED = true;
+#else
+constexpr bool CHECKED = false;
+#endif
+
+template <class Vector>
+inline decltype(auto) access(Vector& vector, std::size_t index)
+{
+    if constexpr (CHECKED)
+    {
+        return vector.at(index);
+    }
+    else
+    {
+        return vector[index];
+    }
+}
+
+//Sampling strategy within a propensity group: rejection sampling, or
+//uniform sampling without rejection for groups whose weights are all equal
+enum SamplingStrategy {REJECTION, UNIFORM_GROUPS};
+
+//Position map for elements that are dense integer indices (0,1,2,...),
+//stored in a flat vector instead of a hash table
+template <class T>
+class DensePositionMap
+{
+public:
+    //Constructor
+    DensePositionMap() : position_vector_(), size_(0) {}
+
+    //Accessors
+    std::size_t size() const {return size_;}
+    std::size_t count(const T& element) const
+        {return index(element) < position_vector_.size() and
+            position_vector_[index(element)].first != EMPTY_;}
+    const SSetPosition& at(const T& element) const
+        {return position_vector_[index(element)];}
+
+    //Mutators
+    SSetPosition& at(const T& element)
+        {return position_vector_[index(element)];}
+    void insert_or_assign(const T& element, const SSetPosition& position);
+    void erase(const T& element);
+    void reserve(std::size_t n);
+    void clear();
+
+private:
+    static constexpr GroupIndex EMPTY_ = std::numeric_limits<GroupIndex>::max();
+    std::vector<SSetPosition> position_vector_;
+    std::size_t size_;
+
+    static std::size_t index(const T& element)
+        {return static_cast<std::size_t>(element);}
+};
+
 //Base class to contain the shared RNG for derived template classes
 class BaseSamplableSet
 {
@@ -56,8 +121,19 @@ class BaseSamplableSet
 /*
  * Set of elements, samplable efficiently using composition and rejection
  * sampling.
+ *
+ * The weights are expected in [min_weight, max_weight]. An adaptive set
+ * instead treats the bounds as an initial guess: any positive and finite
+ * weight is accepted, the range of propensity groups being extended when
+ * needed. The range is extended with some headroom, proportional to its
+ * size, such that the rebuilds are amortized.
+ *
+ * With the UNIFORM_GROUPS strategy, the set tracks for each group the number
+ * of elements having the weight of the first element placed in the group
+ * since it was last empty; when all the elements do, the group is sampled
+ * uniformly without rejection.
  */
-template <class T>
+template <class T, class PositionMap = std::unordered_map<T,SSetPosition> >
 class SamplableSet : public BaseSamplableSet
 {
 public:
@@ -65,12 +141,16 @@ public:
     typedef std::vector<std::pair<T,double> > PropensityGroup;
 
     //Default constructor
-    SamplableSet(double min_weight, double max_weight);
+    SamplableSet(double min_weight, double max_weight, bool adaptive = false,
+            SamplingStrategy strategy = REJECTION);
     //Copy constructor
-    SamplableSet(const SamplableSet<T>& s);
+    SamplableSet(const SamplableSet<T,PositionMap>& s);
 
     //Accessors
     std::size_t size() const {return position_map_.size();}
+    bool is_adaptive() const {return adaptive_;}
+    SamplingStrategy strategy() const {return strategy_;}
+    std::size_t number_of_groups() const {return number_of_group_;}
     bool empty() const {return size() == 0;}
     std::size_t inline count(const T& element) const
         {return position_map_.count(element);}
@@ -82,8 +162,13 @@ public:
     std::optional<std::pair<T,double> > get_at_iterator() const;
 
     //Mutators
+    void reserve(std::size_t n) {position_map_.reserve(n);}
     void insert(const T& element, double weight = 0);
     void set_weight(const T& element, double weight);
+    template <typename ForwardIterator>
+    void set_weights(ForwardIterator first, ForwardIterator last);
+    template <typename ForwardIterator>
+    void assign(ForwardIterator first, ForwardIterator last);
     void erase(const T& element);
     void next();
     void init_iterator();
@@ -93,135 +178,243 @@ public:
 private:
     double min_weight_;
     double max_weight_;
+    bool adaptive_;
+    int exponent_offset_; //exponent of the first propensity group
+    SamplingStrategy strategy_;
     mutable std::uniform_real_distribution<double> random_01_;
     HashPropensity hash_;
     unsigned int number_of_group_;
-    std::vector<double> max_propensity_vector_;
-    std::unordered_map<T,SSetPosition> position_map_;
-    mutable BinaryTree sampling_tree_;
+    std::vector<double> inverse_max_propensity_vector_;
+    PositionMap position_map_;
+    FlatBinaryTree sampling_tree_;
     std::vector<PropensityGroup> propensity_group_vector_;
     mutable typename PropensityGroup::iterator iterator_;
     mutable GroupIndex iterator_group_index_;
+    std::vector<double> variation_vector_;
+    std::vector<GroupIndex> varied_group_vector_;
+    std::vector<double> reference_weight_vector_;
+    std::vector<std::size_t> reference_count_vector_;
     //private method
     void weight_checkup(double weight) const;
+    GroupIndex group_of(double weight);
+    void grow(int first_exponent, int last_exponent);
+    bool is_uniform(GroupIndex group_index) const
+        {return strategy_ == UNIFORM_GROUPS and
+            access(reference_count_vector_, group_index) ==
+            access(propensity_group_vector_, group_index).size();}
+    void count_in(GroupIndex group_index, double weight);
+    void count_out(GroupIndex group_index, double weight);
+    void count_update(GroupIndex group_index, double previous_weight,
+            double weight);
+    void place(const T& element, double weight, GroupIndex group_index);
+    double displace(const T& element);
 };
 
 
 //Default constructor for the class SamplableSet
-template <typename T>
-SamplableSet<T>::SamplableSet(double min_weight, double max_weight) :
+template <typename T, class PositionMap>
+SamplableSet<T,PositionMap>::SamplableSet(double min_weight, double max_weight,
+        bool adaptive, SamplingStrategy strategy) :
     min_weight_(min_weight),
     max_weight_(max_weight),
+    adaptive_(adaptive),
+    exponent_offset_(0),
+    strategy_(strategy),
     random_01_(0.,1.),
     hash_(min_weight, max_weight),
     number_of_group_(hash_(max_weight)+1),
-    max_propensity_vector_(number_of_group_, 2*min_weight),
+    inverse_max_propensity_vector_(number_of_group_, 2*min_weight),
     position_map_(),
     sampling_tree_(number_of_group_),
     propensity_group_vector_(number_of_group_),
     iterator_(),
-    iterator_group_index_(0)
+    iterator_group_index_(0),
+    variation_vector_(number_of_group_, 0.),
+    varied_group_vector_(),
+    reference_weight_vector_(number_of_group_, 0.),
+    reference_count_vector_(number_of_group_, 0)
 {
-    //Initialize max propensity vector
+    //Initialize max propensity vector, then store its inverse
     if (number_of_group_ > 2)
     {
         for (unsigned int i = 0; i < number_of_group_-2; i++)
         {
-            max_propensity_vector_[i+1] = max_propensity_vector_[i]*2;
+            inverse_max_propensity_vector_[i+1] =
+                inverse_max_propensity_vector_[i]*2;
         }
     }
-    max_propensity_vector_.back() = max_weight;
+    //the last group of an adaptive set is not capped by the maximal weight,
+    //since larger weights can join it
+    inverse_max_propensity_vector_.back() = adaptive_ ?
+        std::ldexp(min_weight_, number_of_group_) : max_weight;
+    for (double& inverse_max_propensity : inverse_max_propensity_vector_)
+    {
+        inverse_max_propensity = 1/inverse_max_propensity;
+    }
 }
 
 //Copy constructor
-template <typename T>
-SamplableSet<T>::SamplableSet(const SamplableSet<T>& s) :
+template <typename T, class PositionMap>
+SamplableSet<T,PositionMap>::SamplableSet(const SamplableSet<T,PositionMap>& s) :
+    min_weight_(s.min_weight_),
+    max_weight_(s.max_weight_),
+    adaptive_(s.adaptive_),
+    exponent_offset_(s.exponent_offset_),
+    strategy_(s.strategy_),
     random_01_(0.,1.),
     hash_(s.hash_),
     number_of_group_(s.number_of_group_),
-    max_propensity_vector_(s.max_propensity_vector_),
+    inverse_max_propensity_vector_(s.inverse_max_propensity_vector_),
     position_map_(s.position_map_),
     sampling_tree_(s.sampling_tree_),
     propensity_group_vector_(s.propensity_group_vector_),
     iterator_(),
-    iterator_group_index_(0)
+    iterator_group_index_(0),
+    variation_vector_(s.variation_vector_),
+    varied_group_vector_(),
+    reference_weight_vector_(s.reference_weight_vector_),
+    reference_count_vector_(s.reference_count_vector_)
 {
 }
 
 //throw a invalid_argument error if the weight is out of bounds
-template <typename T>
-void SamplableSet<T>::weight_checkup(double weight) const
+template <typename T, class PositionMap>
+void SamplableSet<T,PositionMap>::weight_checkup(double weight) const
 {
-    if (weight < min_weight_ or weight > max_weight_)
+    if (adaptive_)
+    {
+        if (not (weight > 0) or std::isinf(weight))
+        {
+            throw std::invalid_argument("Weight must be positive and finite");
+        }
+    }
+    else if (weight < min_weight_ or weight > max_weight_)
     {
         throw std::invalid_argument("Weight out of bounds");
     }
 }
 
-//sample an element according to its weight
-template <typename T>
-std::optional<std::pair<T,double> > SamplableSet<T>::sample() const
+//get the propensity group of a valid weight, extending the range of groups
+//if needed
+template <typename T, class PositionMap>
+GroupIndex SamplableSet<T,PositionMap>::group_of(double weight)
 {
-    if (not empty())
+    int exponent = hash_(weight);
+    int first_exponent = exponent_offset_;
+    int last_exponent = exponent_offset_ + int(number_of_group_) - 1;
+    if (exponent < first_exponent or exponent > last_exponent)
     {
-        GroupIndex group_index = sampling_tree_.get_leaf_index(random_01_(gen_));
-        bool element_not_chosen = true;
-        InGroupIndex in_group_index;
-        while (element_not_chosen)
+        //headroom of half the current range in the direction of growth, so
+        //that a sequence of extensions costs O(log(range)) rebuilds
+        int headroom = number_of_group_/2;
+        if (exponent < first_exponent)
+        {
+            first_exponent = exponent - headroom;
+        }
+        else
         {
-            in_group_index = floor(random_01_(gen_)*propensity_group_vector_.at(
-                        group_index).size());
+            last_exponent = exponent + headroom;
+        }
+        grow(first_exponent, last_exponent);
+    }
+    return exponent - exponent_offset_;
+}
 
-            if (random_01_(gen_) <
-                    propensity_group_vector_.at(group_index).at(
-                        in_group_index).second/(max_propensity_vector_.at(
-                            group_index)))
+//extend the range of propensity groups to the exponents [first, last]; the
+//groups are moved and the sampling tree is rebuilt, the positions being
+//shifted when groups are added below
+template <typename T, class PositionMap>
+void SamplableSet<T,PositionMap>::grow(int first_exponent, int last_exponent)
+{
+    GroupIndex shift = exponent_offset_ - first_exponent;
+    unsigned int number_of_group = last_exponent - first_exponent + 1;
+
+    std::vector<PropensityGroup> propensity_group_vector(number_of_group);
+    std::vector<double> variation_vector(number_of_group, 0.);
+    std::vector<double> reference_weight_vector(number_of_group, 0.);
+    std::vector<std::size_t> reference_count_vector(number_of_group, 0);
+    FlatBinaryTree sampling_tree(number_of_group);
+    for (GroupIndex i = 0; i < number_of_group_; i++)
+    {
+        propensity_group_vector[i+shift].swap(propensity_group_vector_[i]);
+        variation_vector[i+shift] = variation_vector_[i];
+        reference_weight_vector[i+shift] = reference_weight_vector_[i];
+        reference_count_vector[i+shift] = reference_count_vector_[i];
+        sampling_tree.update_value(i+shift, sampling_tree_.get_leaf_value(i));
+        if (shift > 0)
+        {
+            for (const auto& element_weight_pair :
+                    propensity_group_vector[i+shift])
             {
-                element_not_chosen = false;
+                position_map_.at(element_weight_pair.first).first += shift;
             }
         }
-        return propensity_group_vector_.at(group_index).at(in_group_index);
     }
-    else
+    for (GroupIndex& group_index : varied_group_vector_)
     {
-        return std::nullopt;
+        group_index += shift;
+    }
+
+    //the upper edge of a group is capped to the largest double, which still
+    //bounds the weights of the group by a factor less than 2
+    inverse_max_propensity_vector_.resize(number_of_group);
+    for (GroupIndex i = 0; i < number_of_group; i++)
+    {
+        inverse_max_propensity_vector_[i] = 1/std::min(std::ldexp(min_weight_,
+                    first_exponent + int(i) + 1),
+                std::numeric_limits<double>::max());
     }
+
+    propensity_group_vector_.swap(propensity_group_vector);
+    variation_vector_.swap(variation_vector);
+    reference_weight_vector_.swap(reference_weight_vector);
+    reference_count_vector_.swap(reference_count_vector);
+    sampling_tree_ = sampling_tree;
+    number_of_group_ = number_of_group;
+    exponent_offset_ = first_exponent;
+    iterator_group_index_ = 0;
+}
+
+//sample an element according to its weight
+template <typename T, class PositionMap>
+std::optional<std::pair<T,double> > SamplableSet<T,PositionMap>::sample() const
+{
+    return sample_ext_RNG(gen_);
 }
 
 //sample an element according to its weight using an external RNG
-template <typename T>
+template <typename T, class PositionMap>
 template <typename ExtRNG>
-std::optional<std::pair<T,double> > SamplableSet<T>::sample_ext_RNG(ExtRNG& gen) const
+std::optional<std::pair<T,double> > SamplableSet<T,PositionMap>::sample_ext_RNG(ExtRNG& gen) const
 {
-    if (not empty())
+    if (empty())
     {
-        GroupIndex group_index = sampling_tree_.get_leaf_index(random_01_(gen));
-        bool element_not_chosen = true;
-        InGroupIndex in_group_index;
-        while (element_not_chosen)
-        {
-            in_group_index = floor(random_01_(gen)*propensity_group_vector_.at(
-                        group_index).size());
-
-            if (random_01_(gen) <
-                    propensity_group_vector_.at(group_index).at(
-                        in_group_index).second/(max_propensity_vector_.at(
-                            group_index)))
-            {
-                element_not_chosen = false;
-            }
-        }
-        return propensity_group_vector_.at(group_index).at(in_group_index);
+        return std::nullopt;
     }
-    else
+    GroupIndex group_index = sampling_tree_.get_leaf_index(random_01_(gen));
+    const PropensityGroup& group = access(propensity_group_vector_,
+            group_index);
+    if (is_uniform(group_index))
     {
-        return std::nullopt;
+        return access(group, std::size_t(random_01_(gen)*group.size()));
+    }
+    double inverse_max_propensity = access(inverse_max_propensity_vector_,
+            group_index);
+    while (true)
+    {
+        const std::pair<T,double>& element_weight_pair = access(group,
+                std::size_t(random_01_(gen)*group.size()));
+        if (random_01_(gen) <
+                element_weight_pair.second*inverse_max_propensity)
+        {
+            return element_weight_pair;
+        }
     }
 }
 
 //get the weight of an element if it exists
-template <typename T>
-std::optional<double> SamplableSet<T>::get_weight(const T& element) const
+template <typename T, class PositionMap>
+std::optional<double> SamplableSet<T,PositionMap>::get_weight(const T& element) const
 {
     if(count(element))
     {
@@ -234,64 +427,310 @@ std::optional<double> SamplableSet<T>::get_weight(const T& element) const
     }
 }
 
+//put an element in a propensity group, without updating the sampling tree
+template <typename T, class PositionMap>
+void SamplableSet<T,PositionMap>::place(const T& element, double weight,
+        GroupIndex group_index)
+{
+    InGroupIndex in_group_index = propensity_group_vector_[group_index].size();
+    count_in(group_index, weight);
+    propensity_group_vector_[group_index].push_back(
+            std::make_pair(element,weight));
+    position_map_.insert_or_assign(element,
+            SSetPosition(group_index, in_group_index));
+}
+
+//remove a present element from its propensity group, without updating the
+//sampling tree, and return its former weight
+template <typename T, class PositionMap>
+double SamplableSet<T,PositionMap>::displace(const T& element)
+{
+    SSetPosition position = position_map_.at(element);
+    //create alias for element and its weight pair
+    std::pair<T, double>& element_weight_pair =
+        propensity_group_vector_[position.first][position.second];
+    double weight = element_weight_pair.second;
+    count_out(position.first, weight);
+    //gives position to last element of propensity group and swap
+    position_map_.at(
+        (propensity_group_vector_[position.first].back()).first) = position;
+    std::swap(element_weight_pair,
+            propensity_group_vector_[position.first].back());
+    //remove
+    propensity_group_vector_[position.first].pop_back();
+    position_map_.erase(element);
+    return weight;
+}
+
 //insert an element in the set with its associated weight
 //if the element is already there, do nothing
-template <typename T>
-void SamplableSet<T>::insert(const T& element, double weight)
+template <typename T, class PositionMap>
+void SamplableSet<T,PositionMap>::insert(const T& element, double weight)
 {
     weight_checkup(weight);
     //insert element only if not present
-    if (position_map_.find(element) == position_map_.end())
-    {
-        GroupIndex group_index = hash_(weight);
-        InGroupIndex in_group_index =
-            propensity_group_vector_[group_index].size();
-        propensity_group_vector_[group_index].push_back(
-                std::make_pair(element,weight));
-        position_map_[element] = SSetPosition(group_index, in_group_index);
+    if (not count(element))
+    {
+        GroupIndex group_index = group_of(weight);
+        place(element, weight, group_index);
         sampling_tree_.update_value(group_index, weight);
     }
 }
 
 //set a new weight for the element in the set
 //if the element does not exists, same as insert
-template <typename T>
-void SamplableSet<T>::set_weight(const T& element, double weight)
+template <typename T, class PositionMap>
+void SamplableSet<T,PositionMap>::set_weight(const T& element, double weight)
 {
     weight_checkup(weight);
+    if (count(element))
+    {
+        const SSetPosition& position = position_map_.at(element);
+        GroupIndex group_index = group_of(weight);
+        if (group_index == position.first)
+        {
+            //same propensity group: update the weight in place
+            std::pair<T, double>& element_weight_pair =
+                propensity_group_vector_[position.first][position.second];
+            sampling_tree_.update_value(group_index,
+                    weight - element_weight_pair.second);
+            count_update(group_index, element_weight_pair.second, weight);
+            element_weight_pair.second = weight;
+            return;
+        }
+    }
     erase(element);
     insert(element, weight);
 }
 
+//set new weights for a sequence of (element, weight) pairs
+//the variations are accumulated per propensity group, such that the
+//sampling tree is updated only once per group; all the weights are checked
+//first, such that a rejected sequence leaves the set unchanged
+template <typename T, class PositionMap>
+template <typename ForwardIterator>
+void SamplableSet<T,PositionMap>::set_weights(ForwardIterator first,
+        ForwardIterator last)
+{
+    for (ForwardIterator it = first; it != last; ++it)
+    {
+        weight_checkup(it->second);
+    }
+    for (; first != last; ++first)
+    {
+        const T& element = first->first;
+        double weight = first->second;
+        GroupIndex group_index = group_of(weight);
+        if (variation_vector_[group_index] == 0.)
+        {
+            varied_group_vector_.push_back(group_index);
+        }
+        if (count(element))
+        {
+            const SSetPosition& position = position_map_.at(element);
+            if (group_index == position.first)
+            {
+                //same propensity group: update the weight in place
+                std::pair<T, double>& element_weight_pair =
+                    propensity_group_vector_[position.first][position.second];
+                variation_vector_[group_index] +=
+                    weight - element_weight_pair.second;
+                count_update(group_index, element_weight_pair.second,
+                        weight);
+                element_weight_pair.second = weight;
+                continue;
+            }
+            GroupIndex previous_group_index = position.first;
+            if (variation_vector_[previous_group_index] == 0.)
+            {
+                varied_group_vector_.push_back(previous_group_index);
+            }
+            variation_vector_[previous_group_index] -= displace(element);
+        }
+        place(element, weight, group_index);
+        variation_vector_[group_index] += weight;
+    }
+    //a group can be listed more than once if its variation went back to 0;
+    //no rounding error must be left to sample an emptied group
+    for (GroupIndex group_index : varied_group_vector_)
+    {
+        if (propensity_group_vector_[group_index].empty())
+        {
+            sampling_tree_.set_value(group_index, 0.);
+        }
+        else if (variation_vector_[group_index] != 0.)
+        {
+            sampling_tree_.update_value(group_index,
+                    variation_vector_[group_index]);
+        }
+        variation_vector_[group_index] = 0.;
+    }
+    varied_group_vector_.clear();
+}
+
+//replace the content of the set by a sequence of (element, weight) pairs
+//the range of groups is extended at most once, the groups are sized in
+//advance and the sampling tree is built once from the sums of the groups;
+//if an element appears more than once, its last weight is kept; all the
+//weights are checked first, such that a rejected sequence leaves the set
+//unchanged
+template <typename T, class PositionMap>
+template <typename ForwardIterator>
+void SamplableSet<T,PositionMap>::assign(ForwardIterator first,
+        ForwardIterator last)
+{
+    int first_exponent = exponent_offset_;
+    int last_exponent = exponent_offset_ + int(number_of_group_) - 1;
+    std::size_t number_of_element = 0;
+    for (ForwardIterator it = first; it != last; ++it)
+    {
+        weight_checkup(it->second);
+        int exponent = hash_(it->second);
+        first_exponent = std::min(first_exponent, exponent);
+        last_exponent = std::max(last_exponent, exponent);
+        number_of_element += 1;
+    }
+    clear();
+    if (first_exponent < exponent_offset_ or last_exponent >=
+            exponent_offset_ + int(number_of_group_))
+    {
+        //same headroom as group_of, on the sides that are extended
+        int headroom = number_of_group_/2;
+        grow(first_exponent - (first_exponent < exponent_offset_ ?
+                    headroom : 0),
+                last_exponent + (last_exponent >= exponent_offset_ +
+                    int(number_of_group_) ? headroom : 0));
+    }
+
+    std::vector<std::size_t> group_size_vector(number_of_group_, 0);
+    for (ForwardIterator it = first; it != last; ++it)
+    {
+        group_size_vector[hash_(it->second) - exponent_offset_] += 1;
+    }
+    for (GroupIndex i = 0; i < number_of_group_; i++)
+    {
+        propensity_group_vector_[i].reserve(group_size_vector[i]);
+    }
+    position_map_.reserve(number_of_element);
+
+    std::vector<double> group_weight_vector(number_of_group_, 0.);
+    for (; first != last; ++first)
+    {
+        const T& element = first->first;
+        double weight = first->second;
+        GroupIndex group_index = hash_(weight) - exponent_offset_;
+        if (count(element))
+        {
+            GroupIndex previous_group_index = position_map_.at(element).first;
+            group_weight_vector[previous_group_index] -= displace(element);
+        }
+        place(element, weight, group_index);
+        group_weight_vector[group_index] += weight;
+    }
+    for (GroupIndex i = 0; i < number_of_group_; i++)
+    {
+        if (propensity_group_vector_[i].empty())
+        {
+            group_weight_vector[i] = 0.; //emptied by repeated elements
+        }
+    }
+    sampling_tree_.assign(group_weight_vector);
+}
+
+//count an element joining a group, the weight of reference of the group
+//being the one of the first element placed since it was last empty
+template <typename T, class PositionMap>
+void SamplableSet<T,PositionMap>::count_in(GroupIndex group_index,
+        double weight)
+{
+    if (strategy_ == UNIFORM_GROUPS)
+    {
+        if (propensity_group_vector_[group_index].empty())
+        {
+            reference_weight_vector_[group_index] = weight;
+            reference_count_vector_[group_index] = 0;
+        }
+        if (weight == reference_weight_vector_[group_index])
+        {
+            reference_count_vector_[group_index] += 1;
+        }
+    }
+}
+
+//count an element leaving a group
+template <typename T, class PositionMap>
+void SamplableSet<T,PositionMap>::count_out(GroupIndex group_index,
+        double weight)
+{
+    if (strategy_ == UNIFORM_GROUPS and
+            weight == reference_weight_vector_[group_index])
+    {
+        reference_count_vector_[group_index] -= 1;
+    }
+}
+
+//count an element of a group changing weight within the group
+template <typename T, class PositionMap>
+void SamplableSet<T,PositionMap>::count_update(GroupIndex group_index,
+        double previous_weight, double weight)
+{
+    if (strategy_ == UNIFORM_GROUPS)
+    {
+        if (propensity_group_vector_[group_index].size() == 1)
+        {
+            reference_weight_vector_[group_index] = weight;
+            reference_count_vector_[group_index] = 1;
+        }
+        else
+        {
+            count_out(group_index, previous_weight);
+            count_in(group_index, weight);
+        }
+    }
+}
+
 //Remove element from the set
-template <typename T>
-void SamplableSet<T>::erase(const T& element)
+template <typename T, class PositionMap>
+void SamplableSet<T,PositionMap>::erase(const T& element)
 {
     //remove element if present
     if (count(element))
     {
-        const SSetPosition& position = position_map_.at(element);
-        //create alias for element and its weight pair
-        std::pair<T, double>& element_weight_pair =
-            propensity_group_vector_[position.first][position.second];
-        sampling_tree_.update_value(position.first, -element_weight_pair.second);
-        //gives position to last element of propensity group and swap
-        position_map_[
-            (propensity_group_vector_[position.first].back()).first] = position;
-        std::swap(element_weight_pair,
-                propensity_group_vector_[position.first].back());
-        //remove
-        propensity_group_vector_[position.first].pop_back();
-        position_map_.erase(element);
+        GroupIndex group_index = position_map_.at(element).first;
+        double weight = displace(element);
+        if (propensity_group_vector_[group_index].empty())
+        {
+            //no rounding error must be left to sample an empty group
+            sampling_tree_.set_value(group_index, 0.);
+        }
+        else
+        {
+            sampling_tree_.update_value(group_index, -weight);
+        }
     }
 }
 
 //Remove all elements from the set
-template <typename T>
-void SamplableSet<T>::clear()
+template <typename T, class PositionMap>
+void SamplableSet<T,PositionMap>::clear()
 {
     sampling_tree_.clear();
-    position_map_.clear();
+    //the positions of a dense map are erased one by one, in O(size) instead
+    //of the size of the whole range of elements
+    if constexpr (std::is_same_v<PositionMap, DensePositionMap<T> >)
+    {
+        for (const auto& group_vector : propensity_group_vector_)
+        {
+            for (const auto& element_weight_pair : group_vector)
+            {
+                position_map_.erase(element_weight_pair.first);
+            }
+        }
+    }
+    else
+    {
+        position_map_.clear();
+    }
     iterator_group_index_ = 0;
     for (auto &group_vector : propensity_group_vector_)
     {
@@ -302,8 +741,8 @@ void SamplableSet<T>::clear()
 
 
 
-template <typename T>
-void SamplableSet<T>::next()
+template <typename T, class PositionMap>
+void SamplableSet<T,PositionMap>::next()
 {
     if (iterator_ != propensity_group_vector_.back().end())
     {
@@ -320,8 +759,8 @@ void SamplableSet<T>::next()
     }
 }
 
-template <typename T>
-std::optional<std::pair<T,double> > SamplableSet<T>::get_at_iterator() const
+template <typename T, class PositionMap>
+std::optional<std::pair<T,double> > SamplableSet<T,PositionMap>::get_at_iterator() const
 {
     if (iterator_ != (propensity_group_vector_.back()).end())
     {
@@ -333,8 +772,8 @@ std::optional<std::pair<T,double> > SamplableSet<T>::get_at_iterator() const
     }
 }
 
-template <typename T>
-void SamplableSet<T>::init_iterator()
+template <typename T, class PositionMap>
+void SamplableSet<T,PositionMap>::init_iterator()
     {
         iterator_group_index_ = 0;
         iterator_ = propensity_group_vector_[0].begin();
@@ -350,6 +789,58 @@ void SamplableSet<T>::init_iterator()
         }
     }
 
+//Samplable set for elements that are dense integer indices
+template <class T>
+using DenseSamplableSet = SamplableSet<T, DensePositionMap<T> >;
+
+
+//insert or update the position of an element, growing the vector if needed
+template <class T>
+void DensePositionMap<T>::insert_or_assign(const T& element,
+        const SSetPosition& position)
+{
+    if (index(element) >= position_vector_.size())
+    {
+        position_vector_.resize(index(element)+1,
+                SSetPosition(EMPTY_, 0));
+    }
+    if (position_vector_[index(element)].first == EMPTY_)
+    {
+        size_ += 1;
+    }
+    position_vector_[index(element)] = position;
+}
+
+//Remove the position of an element if present
+template <class T>
+void DensePositionMap<T>::erase(const T& element)
+{
+    if (count(element))
+    {
+        position_vector_[index(element)].first = EMPTY_;
+        size_ -= 1;
+    }
+}
+
+//Allocate the positions for the elements 0,...,n-1 in advance
+template <class T>
+void DensePositionMap<T>::reserve(std::size_t n)
+{
+    if (n > position_vector_.size())
+    {
+        position_vector_.resize(n, SSetPosition(EMPTY_, 0));
+    }
+}
+
+//Remove all positions, but keep the memory
+template <class T>
+void DensePositionMap<T>::clear()
+{
+    std::fill(position_vector_.begin(), position_vector_.end(),
+            SSetPosition(EMPTY_, 0));
+    size_ = 0;
+}
+
 }//end of namespace sset
 
 #endif /* SAMPLABLESET_HPP_ */
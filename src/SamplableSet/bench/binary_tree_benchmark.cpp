@@ -0,0 +1,118 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Guillaume St-Onge
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*
+ * Compare the pointer-based BinaryTree with the array-based FlatBinaryTree
+ * for the two operations performed on every event by SamplableSet: drawing a
+ * leaf from the cumulative distribution and updating the value of a leaf.
+ */
+
+#include "BinaryTree.hpp"
+#include "FlatBinaryTree.hpp"
+#include "pcg-cpp/include/pcg_random.hpp"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+using namespace sset;
+
+//random numbers are drawn in advance to measure only the tree operations
+const std::size_t NUMBER_OF_DRAWS = 1 << 14;
+
+std::vector<double> random_fractions()
+{
+    pcg32 gen(42);
+    std::uniform_real_distribution<double> random_01(0., 1.);
+    std::vector<double> fractions(NUMBER_OF_DRAWS);
+    for (double& r : fractions)
+    {
+        r = random_01(gen);
+    }
+    return fractions;
+}
+
+std::vector<LeafIndex> random_leaves(unsigned int n_leaves)
+{
+    pcg32 gen(43);
+    std::uniform_int_distribution<LeafIndex> random_leaf(0, n_leaves-1);
+    std::vector<LeafIndex> leaves(NUMBER_OF_DRAWS);
+    for (LeafIndex& leaf : leaves)
+    {
+        leaf = random_leaf(gen);
+    }
+    return leaves;
+}
+
+//fill the leaves with values spanning a few orders of magnitude, as the
+//propensity groups of a SamplableSet do
+template <class Tree>
+Tree filled_tree(unsigned int n_leaves)
+{
+    Tree tree(n_leaves);
+    for (LeafIndex leaf = 0; leaf < n_leaves; leaf++)
+    {
+        tree.update_value(leaf, 1. + leaf%7);
+    }
+    return tree;
+}
+
+template <class Tree>
+static void BM_sample(benchmark::State& state)
+{
+    unsigned int n_leaves = state.range(0);
+    Tree tree = filled_tree<Tree>(n_leaves);
+    std::vector<double> fractions = random_fractions();
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(tree.get_leaf_index(
+                    fractions[i++ % NUMBER_OF_DRAWS]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <class Tree>
+static void BM_update(benchmark::State& state)
+{
+    unsigned int n_leaves = state.range(0);
+    Tree tree = filled_tree<Tree>(n_leaves);
+    std::vector<LeafIndex> leaves = random_leaves(n_leaves);
+    std::size_t i = 0;
+    double variation = 1.;
+    for (auto _ : state)
+    {
+        tree.update_value(leaves[i++ % NUMBER_OF_DRAWS], variation);
+        variation = -variation; //keep the values bounded
+    }
+    benchmark::DoNotOptimize(tree.get_value());
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_sample, BinaryTree)->RangeMultiplier(2)->Range(4, 1024);
+BENCHMARK_TEMPLATE(BM_sample, FlatBinaryTree)->RangeMultiplier(2)->Range(4, 1024);
+BENCHMARK_TEMPLATE(BM_update, BinaryTree)->RangeMultiplier(2)->Range(4, 1024);
+BENCHMARK_TEMPLATE(BM_update, FlatBinaryTree)->RangeMultiplier(2)->Range(4, 1024);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,85 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Guillaume St-Onge
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*
+ * Compare the exponent extraction of HashPropensity with the former
+ * floor(log2(propensity/min)), computed on every insertion and weight update
+ * of a SamplableSet.
+ */
+
+#include "HashPropensity.hpp"
+#include "pcg-cpp/include/pcg_random.hpp"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+#include <cmath>
+
+using namespace sset;
+
+const std::size_t NUMBER_OF_DRAWS = 1 << 14;
+
+//propensities log-uniform over [1e-3,1e3]
+std::vector<double> random_propensities()
+{
+    pcg32 gen(42);
+    std::uniform_real_distribution<double> exponent(-3., 3.);
+    std::vector<double> propensities(NUMBER_OF_DRAWS);
+    for (double& propensity : propensities)
+    {
+        propensity = std::pow(10., exponent(gen));
+    }
+    return propensities;
+}
+
+static void BM_log2_hash(benchmark::State& state)
+{
+    std::vector<double> propensities = random_propensities();
+    double propensity_min = 1e-3;
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(int(std::floor(std::log2(
+                            propensities[i++ % NUMBER_OF_DRAWS]
+                            /propensity_min))));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_exponent_hash(benchmark::State& state)
+{
+    std::vector<double> propensities = random_propensities();
+    HashPropensity hash(1e-3, 1e3);
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(hash(propensities[i++ % NUMBER_OF_DRAWS]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_log2_hash);
+BENCHMARK(BM_exponent_hash);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,312 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Guillaume St-Onge
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*
+ * Benchmark the operations of SamplableSet: sample, insert, assign and
+ * erase for sizes from 10^2 to 10^8 elements, to track regressions; the
+ * cost of extending the range of propensity groups of an adaptive set, compared to a set whose bounds
+ * are known in advance, and the cost of the wasted groups when the bounds
+ * are set far wider than the weights. The sampling strategies are compared
+ * for weights that are constant, take a few integer values, or are spread.
+ */
+
+#include "SamplableSet.hpp"
+#include "pcg-cpp/include/pcg_random.hpp"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <optional>
+#include <cmath>
+
+using namespace sset;
+
+//weights log-uniform over [2^-span/2, 2^span/2)
+std::vector<double> spread_weights(std::size_t n, int span)
+{
+    pcg32 gen(42);
+    std::uniform_real_distribution<double> exponent(-span/2., span/2.);
+    std::vector<double> weights(n);
+    for (double& weight : weights)
+    {
+        weight = std::exp2(exponent(gen));
+    }
+    return weights;
+}
+
+//set of n elements with log-uniform weights over 8 octaves
+DenseSamplableSet<unsigned int> filled_set(std::size_t n)
+{
+    std::vector<double> weights = spread_weights(n, 8);
+    DenseSamplableSet<unsigned int> set(1./16, 16.);
+    set.reserve(n);
+    for (unsigned int i = 0; i < n; i++)
+    {
+        set.insert(i, weights[i]);
+    }
+    return set;
+}
+
+static void BM_sample_size(benchmark::State& state)
+{
+    DenseSamplableSet<unsigned int> set = filled_set(state.range(0));
+    pcg32 gen(43);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(set.sample_ext_RNG(gen));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+//insert n elements in an empty set
+static void BM_insert_size(benchmark::State& state)
+{
+    std::size_t n = state.range(0);
+    std::vector<double> weights = spread_weights(n, 8);
+    //the previous set is destroyed while the timing is paused
+    std::optional<DenseSamplableSet<unsigned int>> set;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        set.emplace(1./16, 16.);
+        set->reserve(n);
+        state.ResumeTiming();
+        for (unsigned int i = 0; i < n; i++)
+        {
+            set->insert(i, weights[i]);
+        }
+        benchmark::DoNotOptimize(set->total_weight());
+    }
+    state.SetItemsProcessed(state.iterations()*n);
+}
+
+//build a set of n elements at once from (element, weight) pairs
+static void BM_assign_size(benchmark::State& state)
+{
+    std::size_t n = state.range(0);
+    std::vector<double> weights = spread_weights(n, 8);
+    std::vector<std::pair<unsigned int,double>> pairs(n);
+    for (unsigned int i = 0; i < n; i++)
+    {
+        pairs[i] = std::make_pair(i, weights[i]);
+    }
+    std::optional<DenseSamplableSet<unsigned int>> set;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        set.emplace(1./16, 16.);
+        state.ResumeTiming();
+        set->assign(pairs.begin(), pairs.end());
+        benchmark::DoNotOptimize(set->total_weight());
+    }
+    state.SetItemsProcessed(state.iterations()*n);
+}
+
+//erase the n elements of a set in random order
+static void BM_erase_size(benchmark::State& state)
+{
+    std::size_t n = state.range(0);
+    std::vector<unsigned int> elements(n);
+    std::iota(elements.begin(), elements.end(), 0);
+    std::shuffle(elements.begin(), elements.end(), pcg32(45));
+    std::optional<DenseSamplableSet<unsigned int>> set;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        set.reset();
+        set.emplace(filled_set(n));
+        state.ResumeTiming();
+        for (unsigned int element : elements)
+        {
+            set->erase(element);
+        }
+        benchmark::DoNotOptimize(set->total_weight());
+    }
+    state.SetItemsProcessed(state.iterations()*n);
+}
+
+//bounds of the set: exact, adaptive starting at [1,1], or very wide
+enum class Bounds {exact, adaptive, wide};
+
+DenseSamplableSet<unsigned int> make_set(Bounds bounds, int span)
+{
+    switch (bounds)
+    {
+        case Bounds::exact:
+            return DenseSamplableSet<unsigned int>(std::exp2(-span/2.),
+                    std::exp2(span/2.));
+        case Bounds::adaptive:
+            return DenseSamplableSet<unsigned int>(1., 1., true);
+        default:
+            return DenseSamplableSet<unsigned int>(1e-150, 1e150);
+    }
+}
+
+//fill a set from scratch, the weights being sorted in decreasing order
+//for the worst case of an adaptive set, which must then extend its range
+//below on every new smallest weight
+template <Bounds B>
+static void BM_fill(benchmark::State& state)
+{
+    std::size_t n = state.range(0);
+    int span = state.range(1);
+    std::vector<double> weights = spread_weights(n, span);
+    std::sort(weights.begin(), weights.end(), std::greater<double>());
+    for (auto _ : state)
+    {
+        DenseSamplableSet<unsigned int> set = make_set(B, span);
+        set.reserve(n);
+        for (unsigned int i = 0; i < n; i++)
+        {
+            set.insert(i, weights[i]);
+        }
+        benchmark::DoNotOptimize(set.total_weight());
+    }
+    state.SetItemsProcessed(state.iterations()*n);
+}
+
+template <Bounds B>
+static void BM_sample(benchmark::State& state)
+{
+    std::size_t n = state.range(0);
+    int span = state.range(1);
+    std::vector<double> weights = spread_weights(n, span);
+    DenseSamplableSet<unsigned int> set = make_set(B, span);
+    for (unsigned int i = 0; i < n; i++)
+    {
+        set.insert(i, weights[i]);
+    }
+    pcg32 gen(43);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(set.sample_ext_RNG(gen));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+//distribution of the weights for the comparison of the strategies
+enum class Weights {constant, integer, spread};
+
+std::vector<double> strategy_weights(std::size_t n, Weights distribution)
+{
+    pcg32 gen(44);
+    std::uniform_int_distribution<int> count(1, 8);
+    std::vector<double> weights = spread_weights(n, 8);
+    for (double& weight : weights)
+    {
+        if (distribution == Weights::constant)
+        {
+            weight = 1.;
+        }
+        else if (distribution == Weights::integer)
+        {
+            weight = count(gen); //e.g. rates proportional to counts
+        }
+    }
+    return weights;
+}
+
+template <SamplingStrategy S, Weights W>
+static void BM_sample_strategy(benchmark::State& state)
+{
+    std::size_t n = state.range(0);
+    std::vector<double> weights = strategy_weights(n, W);
+    DenseSamplableSet<unsigned int> set(1./16, 16., false, S);
+    for (unsigned int i = 0; i < n; i++)
+    {
+        set.insert(i, weights[i]);
+    }
+    pcg32 gen(43);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(set.sample_ext_RNG(gen));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+//cost of the bookkeeping of the strategy on updates
+template <SamplingStrategy S, Weights W>
+static void BM_set_weight_strategy(benchmark::State& state)
+{
+    std::size_t n = state.range(0);
+    std::vector<double> weights = strategy_weights(n, W);
+    DenseSamplableSet<unsigned int> set(1./16, 16., false, S);
+    for (unsigned int i = 0; i < n; i++)
+    {
+        set.insert(i, weights[i]);
+    }
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        //each element takes the weight of another one
+        set.set_weight(i % n, weights[(i*7919) % n]);
+        i++;
+    }
+    benchmark::DoNotOptimize(set.total_weight());
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void spans(benchmark::internal::Benchmark* benchmark)
+{
+    for (int span : {4, 32, 256})
+    {
+        benchmark->Args({1 << 16, span});
+    }
+}
+
+BENCHMARK(BM_sample_size)->RangeMultiplier(10)->Range(100, 100000000);
+BENCHMARK(BM_insert_size)->RangeMultiplier(10)->Range(100, 100000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_assign_size)->RangeMultiplier(10)->Range(100, 100000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_erase_size)->RangeMultiplier(10)->Range(100, 100000000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_fill, Bounds::exact)->Apply(spans);
+BENCHMARK_TEMPLATE(BM_fill, Bounds::adaptive)->Apply(spans);
+BENCHMARK_TEMPLATE(BM_sample, Bounds::exact)->Apply(spans);
+BENCHMARK_TEMPLATE(BM_sample, Bounds::adaptive)->Apply(spans);
+BENCHMARK_TEMPLATE(BM_sample, Bounds::wide)->Apply(spans);
+
+BENCHMARK_TEMPLATE(BM_sample_strategy, REJECTION, Weights::constant)
+    ->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_sample_strategy, UNIFORM_GROUPS, Weights::constant)
+    ->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_sample_strategy, REJECTION, Weights::integer)
+    ->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_sample_strategy, UNIFORM_GROUPS, Weights::integer)
+    ->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_sample_strategy, REJECTION, Weights::spread)
+    ->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_sample_strategy, UNIFORM_GROUPS, Weights::spread)
+    ->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_set_weight_strategy, REJECTION, Weights::integer)
+    ->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_set_weight_strategy, UNIFORM_GROUPS, Weights::integer)
+    ->Arg(1 << 16);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,167 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Guillaume St-Onge
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*
+ * Equivalence of the exponent extraction of HashPropensity with the former
+ * implementation floor(log2(propensity/min)). The two agree except within
+ * a few ulps of the group edges min*2^k, where the division and logarithm
+ * may round across the edge; there, the group must be the exact one, which
+ * is checked against the edges computed with ldexp.
+ */
+
+#include "HashPropensity.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+using namespace sset;
+using namespace std;
+
+//former implementation
+int log2_hash(double propensity, double propensity_min,
+        double propensity_max)
+{
+    int index = floor(log2(propensity/propensity_min));
+    if (floor(log2(propensity_max/propensity_min)) ==
+            ceil(log2(propensity_max/propensity_min)) and
+            propensity_max != propensity_min and
+            propensity == propensity_max)
+    {
+        index -= 1;
+    }
+    return index;
+}
+
+//exact group: min*2^k <= propensity < min*2^(k+1), for scalings of the
+//minimum that are exact
+int exact_hash(double propensity, double propensity_min)
+{
+    int index = floor(log2(propensity/propensity_min));
+    while (ldexp(propensity_min, index) > propensity)
+    {
+        index -= 1;
+    }
+    while (ldexp(propensity_min, index+1) <= propensity)
+    {
+        index += 1;
+    }
+    return index;
+}
+
+int number_of_failures = 0;
+long number_of_checks = 0;
+long number_of_rounding_differences = 0;
+
+void check(double propensity, double propensity_min, double propensity_max)
+{
+    HashPropensity hash(propensity_min, propensity_max);
+    int index = hash(propensity);
+    int expected = exact_hash(propensity, propensity_min);
+    if (propensity == propensity_max and
+            log2_hash(propensity_max, propensity_min, propensity_max) <
+            exact_hash(propensity_max, propensity_min))
+    {
+        expected -= 1; //maximum closing a power-of-two range
+    }
+    number_of_checks += 1;
+    if (index != log2_hash(propensity, propensity_min, propensity_max))
+    {
+        number_of_rounding_differences += 1;
+    }
+    if (index != expected)
+    {
+        number_of_failures += 1;
+        if (number_of_failures <= 10)
+        {
+            printf("propensity %.17g min %.17g max %.17g: %d instead of %d\n",
+                    propensity, propensity_min, propensity_max, index,
+                    expected);
+        }
+    }
+}
+
+int main()
+{
+    vector<double> minima = {1., 0.1, 3., 1e-3, 0.7, 1./3};
+
+    //all single-precision mantissas of the first octave above the minimum
+    for (double propensity_min : minima)
+    {
+        for (uint32_t bits = 0; bits < (1u << 23); bits++)
+        {
+            double mantissa = 1. + ldexp(double(bits), -23);
+            check(mantissa*propensity_min, propensity_min, 1e6);
+        }
+    }
+
+    //16 ulps around every group edge min*2^k over the range of normal
+    //doubles, and the edges themselves
+    for (double propensity_min : minima)
+    {
+        for (int k = -1000; k <= 1000; k++)
+        {
+            double edge = ldexp(propensity_min, k);
+            double below = edge;
+            double above = edge;
+            check(edge, propensity_min, 1e6);
+            for (int ulp = 0; ulp < 16; ulp++)
+            {
+                below = nextafter(below, 0.);
+                above = nextafter(above, numeric_limits<double>::max());
+                check(below, propensity_min, 1e6);
+                check(above, propensity_min, 1e6);
+            }
+        }
+    }
+
+    //subnormal propensities and minimum
+    for (double propensity = numeric_limits<double>::denorm_min();
+            propensity < 1e-300; propensity *= 3)
+    {
+        check(propensity, 1., 1.);
+        check(propensity, numeric_limits<double>::denorm_min(), 1.);
+    }
+
+    //maximum closing the last group when max/min is a power of two, or not
+    for (double propensity_min : minima)
+    {
+        for (int k = 0; k <= 20; k++)
+        {
+            double propensity_max = ldexp(propensity_min, k);
+            check(propensity_max, propensity_min, propensity_max);
+            check(nextafter(propensity_max, 0.), propensity_min,
+                    propensity_max);
+            check(propensity_max, propensity_min,
+                    nextafter(propensity_max, 2*propensity_max));
+        }
+    }
+
+    printf("%ld checks, %ld rounding differences with log2, %d failures\n",
+            number_of_checks, number_of_rounding_differences,
+            number_of_failures);
+    return number_of_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
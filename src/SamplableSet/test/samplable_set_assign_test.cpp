@@ -0,0 +1,194 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Guillaume St-Onge
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Equivalence of the bulk assignment of a SamplableSet with the insertion
+ * of the same (element, weight) pairs in an empty set: same weights, same
+ * total weight, no more groups, and samples with the right weights.
+ * The sets are compared with both position maps and both strategies, for
+ * adaptive sets whose range must be extended, repeated elements, and an
+ * assignment replacing a non-empty set. A rejected batch of weights must
+ * leave the set unchanged, and so must a rejected assignment. A cleared dense
+ * set must forget its elements.
+ */
+
+#include "SamplableSet.hpp"
+#include "pcg-cpp/include/pcg_random.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace sset;
+using namespace std;
+
+int number_of_failures = 0;
+
+void expect(bool condition, const string& message)
+{
+    if (not condition)
+    {
+        number_of_failures += 1;
+        printf("failure: %s\n", message.c_str());
+    }
+}
+
+//n pairs with elements drawn in [0, 2n), such that some are repeated, and
+//weights log-uniform over the given exponents
+vector<pair<unsigned int,double>> random_pairs(size_t n, double low,
+        double high, unsigned int seed)
+{
+    pcg32 gen(seed);
+    uniform_int_distribution<unsigned int> element(0, 2*n-1);
+    uniform_real_distribution<double> exponent(low, high);
+    vector<pair<unsigned int,double>> pairs(n);
+    for (auto& element_weight_pair : pairs)
+    {
+        element_weight_pair = make_pair(element(gen), exp2(exponent(gen)));
+    }
+    return pairs;
+}
+
+template <class Set>
+void compare(Set& assigned, Set& inserted, size_t n, const string& name)
+{
+    expect(assigned.size() == inserted.size(), name + ": size");
+    //the range is extended at once instead of step by step
+    expect(assigned.number_of_groups() <= inserted.number_of_groups(),
+            name + ": number of groups");
+    expect(fabs(assigned.total_weight() - inserted.total_weight()) <=
+            1e-12*inserted.total_weight(), name + ": total weight");
+    for (unsigned int element = 0; element < 2*n; element++)
+    {
+        expect(assigned.get_weight(element) == inserted.get_weight(element),
+                name + ": weight of " + to_string(element));
+    }
+    pcg32 gen(7);
+    for (int i = 0; i < 1000; i++)
+    {
+        auto element_weight_pair = assigned.sample_ext_RNG(gen);
+        expect(assigned.empty() ? not element_weight_pair :
+                element_weight_pair and
+                assigned.get_weight(element_weight_pair->first) ==
+                element_weight_pair->second, name + ": sample");
+    }
+}
+
+template <class Set>
+void check(size_t n, double low, double high, bool adaptive,
+        SamplingStrategy strategy, const string& name)
+{
+    vector<pair<unsigned int,double>> pairs = random_pairs(n, low, high, 3);
+    Set assigned(1., 2., adaptive, strategy);
+    Set inserted(1., 2., adaptive, strategy);
+    assigned.assign(pairs.begin(), pairs.end());
+    inserted.set_weights(pairs.begin(), pairs.end());
+    compare(assigned, inserted, n, name);
+
+    //assign over a non-empty set
+    pairs = random_pairs(n, low, high, 5);
+    assigned.assign(pairs.begin(), pairs.end());
+    inserted.clear();
+    inserted.set_weights(pairs.begin(), pairs.end());
+    compare(assigned, inserted, n, name + " (reassigned)");
+}
+
+int main()
+{
+    typedef SamplableSet<unsigned int> HashSet;
+    typedef DenseSamplableSet<unsigned int> DenseSet;
+    for (SamplingStrategy strategy : {REJECTION, UNIFORM_GROUPS})
+    {
+        string suffix = strategy == REJECTION ? "" : ", uniform groups";
+        check<HashSet>(10000, 0., 1., false, strategy, "hash" + suffix);
+        check<DenseSet>(10000, 0., 1., false, strategy, "dense" + suffix);
+        check<DenseSet>(10000, -40., 60., true, strategy,
+                "dense adaptive" + suffix);
+        check<HashSet>(10000, -40., 60., true, strategy,
+                "hash adaptive" + suffix);
+        check<DenseSet>(0, 0., 1., false, strategy, "empty" + suffix);
+    }
+
+    //constant weights are sampled without rejection
+    vector<pair<unsigned int,double>> pairs;
+    for (unsigned int element = 0; element < 100; element++)
+    {
+        pairs.push_back(make_pair(element, 1.5));
+    }
+    DenseSet set(1., 2., false, UNIFORM_GROUPS);
+    set.assign(pairs.begin(), pairs.end());
+    expect(set.total_weight() == 150., "constant weights: total weight");
+
+    //weights out of bounds are rejected
+    bool thrown = false;
+    pairs.push_back(make_pair(100, 3.));
+    try
+    {
+        set.assign(pairs.begin(), pairs.end());
+    }
+    catch (const invalid_argument&)
+    {
+        thrown = true;
+    }
+    expect(thrown, "weight out of bounds");
+    expect(set.size() == 100 and set.total_weight() == 150. and
+            set.get_weight(99) == 1.5 and not set.count(100),
+            "rejected assignment");
+
+    //a rejected batch of weights leaves the set unchanged
+    DenseSet batch_set(1., 2.);
+    vector<pair<unsigned int,double>> batch = {{0, 1.5}, {1, 1.25}};
+    batch_set.set_weights(batch.begin(), batch.end());
+    batch = {{0, 1.75}, {2, 1.5}, {3, 3.}};
+    thrown = false;
+    try
+    {
+        batch_set.set_weights(batch.begin(), batch.end());
+    }
+    catch (const invalid_argument&)
+    {
+        thrown = true;
+    }
+    expect(thrown and batch_set.size() == 2 and
+            batch_set.get_weight(0) == 1.5 and not batch_set.count(2) and
+            batch_set.total_weight() == 2.75, "rejected batch of weights");
+
+    //a cleared dense set forgets its elements, wherever they are
+    DenseSet sparse_set(1., 2.);
+    sparse_set.insert(5, 1.5);
+    sparse_set.insert(1000000, 1.25);
+    sparse_set.clear();
+    expect(sparse_set.empty() and not sparse_set.count(5) and
+            not sparse_set.count(1000000) and
+            sparse_set.total_weight() == 0., "cleared dense set");
+    sparse_set.insert(1000000, 1.5);
+    expect(sparse_set.size() == 1 and
+            sparse_set.get_weight(1000000) == 1.5, "refilled dense set");
+
+    printf("%d failures\n", number_of_failures);
+    return number_of_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,147 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Guillaume St-Onge
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * A propensity group emptied by erase, set_weight, set_weights or assign
+ * must never be sampled, whatever the rounding errors accumulated by its
+ * weight in the sampling tree. A group of weights close to 1 is emptied
+ * while an element of weight 1e-14 remains, such that a residue of the
+ * order of the machine precision would be sampled a few percent of the time.
+ */
+
+#include "SamplableSet.hpp"
+#include "pcg-cpp/include/pcg_random.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace sset;
+using namespace std;
+
+int number_of_failures = 0;
+
+void expect(bool condition, const string& message)
+{
+    if (not condition)
+    {
+        number_of_failures += 1;
+        printf("failure: %s\n", message.c_str());
+    }
+}
+
+const double SMALL_WEIGHT = 1e-14;
+
+//the weights are added and removed in different orders, which leaves a
+//residue in floating point arithmetic
+const vector<pair<unsigned int,double>> LARGE_PAIRS =
+    {{1, 1.1}, {2, 1.3}, {3, 1.7}};
+const vector<pair<unsigned int,double>> REMOVAL_ORDER =
+    {{1, 1.1}, {3, 1.7}, {2, 1.3}};
+
+template <class Set>
+void expect_only_small(const Set& set, const string& name)
+{
+    expect(set.size() == 1, name + ": size");
+    //the remaining group may keep its own rounding errors, not the others
+    expect(fabs(set.total_weight() - SMALL_WEIGHT) <= 1e-12*SMALL_WEIGHT,
+            name + ": total weight");
+    pcg32 gen(11);
+    bool only_small = true;
+    for (int i = 0; i < 100000; i++)
+    {
+        only_small = only_small and
+            set.sample_ext_RNG(gen)->first == 0;
+    }
+    expect(only_small, name + ": sample");
+}
+
+template <class Set>
+void check(const string& name)
+{
+    //erase
+    Set set(1., 2., true);
+    set.insert(0, SMALL_WEIGHT);
+    for (const auto& element_weight_pair : LARGE_PAIRS)
+    {
+        set.insert(element_weight_pair.first, element_weight_pair.second);
+    }
+    for (const auto& element_weight_pair : REMOVAL_ORDER)
+    {
+        set.erase(element_weight_pair.first);
+    }
+    expect_only_small(set, name + ", erase");
+
+    //set_weight moving the elements to the group of the small weight
+    set.set_weights(LARGE_PAIRS.begin(), LARGE_PAIRS.end());
+    for (const auto& element_weight_pair : REMOVAL_ORDER)
+    {
+        set.set_weight(element_weight_pair.first, SMALL_WEIGHT);
+    }
+    for (const auto& element_weight_pair : REMOVAL_ORDER)
+    {
+        set.erase(element_weight_pair.first);
+    }
+    expect_only_small(set, name + ", set_weight");
+
+    //set_weights, emptying the group in a later batch
+    set.set_weights(LARGE_PAIRS.begin(), LARGE_PAIRS.end());
+    vector<pair<unsigned int,double>> batch;
+    for (const auto& element_weight_pair : REMOVAL_ORDER)
+    {
+        batch.push_back(make_pair(element_weight_pair.first, SMALL_WEIGHT));
+    }
+    set.set_weights(batch.begin(), batch.end());
+    for (const auto& element_weight_pair : REMOVAL_ORDER)
+    {
+        set.erase(element_weight_pair.first);
+    }
+    expect_only_small(set, name + ", set_weights");
+
+    //assign, the large weights being replaced by repeated elements
+    vector<pair<unsigned int,double>> pairs = {{0, SMALL_WEIGHT}};
+    pairs.insert(pairs.end(), LARGE_PAIRS.begin(), LARGE_PAIRS.end());
+    for (const auto& element_weight_pair : REMOVAL_ORDER)
+    {
+        pairs.push_back(make_pair(element_weight_pair.first, 1e-3));
+    }
+    Set assigned(1., 2., true);
+    assigned.assign(pairs.begin(), pairs.end());
+    for (const auto& element_weight_pair : REMOVAL_ORDER)
+    {
+        assigned.erase(element_weight_pair.first);
+    }
+    expect_only_small(assigned, name + ", assign");
+}
+
+int main()
+{
+    check<SamplableSet<unsigned int>>("hash");
+    check<DenseSamplableSet<unsigned int>>("dense");
+
+    printf("%d failures\n", number_of_failures);
+    return number_of_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -39,7 +39,17 @@ Time::Time(): name_("time"),
 //return the time
 vector<double> Time::get_result() const
 {
-    return time_vector_;
+    return vector<double>(time_vector_.begin(), time_vector_.end());
+}
+
+//return the time measured from a certain index, to fetch incrementally
+vector<double> Time::get_result_since(size_t offset) const
+{
+    if (offset >= time_vector_.size())
+    {
+        return vector<double>();
+    }
+    return vector<double>(time_vector_.begin() + offset, time_vector_.end());
 }
 
 //perform a measure on the contagion process
@@ -49,4 +59,11 @@ void Time::measure(
     time_vector_.push_back(ptr->get_current_time());
 }
 
+//append the results of another measure
+void Time::merge(const Measure& measure)
+{
+    const Time& other = dynamic_cast<const Time&>(measure);
+    time_vector_.append(other.time_vector_);
+}
+
 }//end of namespace schon
@@ -26,7 +26,9 @@
 #define TIME_HPP_
 
 #include "Measure.hpp"
+#include "ResultBuffer.hpp"
 #include <vector>
+#include <memory>
 
 namespace schon
 {//start of namespace schon
@@ -39,18 +41,23 @@ public:
 
     //Acessors
     std::vector<double> get_result() const;
+    std::vector<double> get_result_since(std::size_t offset) const;
+    //snapshot of the result, left untouched by later measures
+    ResultBuffer::Snapshot get_shared_result() const
+        {return time_vector_.snapshot();}
     const std::string& get_name() const
         {return name_;}
 
     //Mutators
     void measure(ContagionProcess const * const ptr);
+    void merge(const Measure& measure);
     void clear()
         {time_vector_.clear();}
 
 private:
     //Members
     const std::string name_;
-    std::vector<double> time_vector_;
+    ResultBuffer time_vector_;
 };
 
 }//end of namespace schon
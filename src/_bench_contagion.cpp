@@ -0,0 +1,113 @@
+/*
+ * Measure the number of events per second performed by the engines on a
+ * large random hypergraph, through their complete evolution loop. The
+ * events are counted by a measure of the time taken before each of them,
+ * which adds the same small cost to every engine; for the discrete-time
+ * SIS, an event is a time step.
+ *
+ * usage: ./bench_contagion [number_of_nodes] [period]
+ */
+#include "ContinuousSIS.hpp"
+#include "DiscreteSIS.hpp"
+#include "PowerlawGroupSIS.hpp"
+#include <iostream>
+#include <chrono>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <memory>
+
+using namespace std;
+using namespace schon;
+
+//each node belongs to 3 groups of size 5, assigned at random
+EdgeList random_hypergraph(size_t number_of_nodes)
+{
+    const size_t membership = 3;
+    const size_t group_size = 5;
+    const size_t groups_per_layer = number_of_nodes/group_size;
+    vector<Node> nodes(groups_per_layer*group_size);
+    iota(nodes.begin(), nodes.end(), 0);
+    sset::RNGType gen(42);
+    EdgeList edge_list;
+    //each layer is a random partition of the nodes into groups
+    for (size_t layer = 0; layer < membership; layer++)
+    {
+        shuffle(nodes.begin(), nodes.end(), gen);
+        for (size_t i = 0; i < nodes.size(); i++)
+        {
+            edge_list.push_back(make_pair(nodes[i],
+                        layer*groups_per_layer + i/group_size));
+        }
+    }
+    return edge_list;
+}
+
+template <class Process>
+void run(const string& name, Process& process, double period)
+{
+    process.seed(42);
+    process.infect_fraction(0.1);
+    process.evolve(period/10); //burn-in
+    //with a decorrelation time of 0, a measure is taken before each event
+    process.measure_time();
+    auto start = chrono::steady_clock::now();
+    process.evolve(period, 0., true);
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    size_t count = dynamic_pointer_cast<Time>(
+            process.get_measure_vector().back())->get_result().size();
+    cout << name << ": " << count/elapsed.count() << " events/sec ("
+        << count << " events in " << elapsed.count() << " sec, "
+        << process.get_number_of_infected_nodes() << " infected)" << endl;
+}
+
+int main(int argc, const char *argv[])
+{
+    size_t number_of_nodes = argc > 1 ? stoul(argv[1]) : 1000000;
+    double period = argc > 2 ? stod(argv[2]) : 2.;
+    EdgeList edge_list = random_hypergraph(number_of_nodes);
+
+    double recovery_rate = 1.;
+    double scale = 0.2;
+    size_t max_size = 5;
+    vector<vector<double>> infection_rate(max_size+1,
+            vector<double>(max_size+1, 0.));
+    for (size_t n = 2; n <= max_size; n++)
+    {
+        for (size_t i = 0; i <= n; i++)
+        {
+            infection_rate[n][i] = scale*i;
+        }
+    }
+    size_t number_of_groups = max_element(edge_list.begin(), edge_list.end(),
+            [](const pair<Node,Group>& a, const pair<Node,Group>& b)
+            {return a.second < b.second;})->second + 1;
+    vector<double> group_transmission_rate(number_of_groups, 1.);
+
+    ContinuousSIS continuous_sis(edge_list, recovery_rate,
+            infection_rate, group_transmission_rate);
+    run("ContinuousSIS", continuous_sis, period);
+
+    PowerlawGroupSIS group_sis(edge_list, recovery_rate, scale,
+            1., make_pair(scale, scale*max_size*max_size));
+    run("PowerlawGroupSIS", group_sis, period);
+
+    LinearGroupSIS linear_sis(edge_list, recovery_rate,
+            LinearRate(scale), make_pair(scale, scale*max_size*max_size));
+    run("LinearGroupSIS", linear_sis, period);
+
+    //probabilities per time step, for the same rates over a step of 0.1
+    vector<vector<double>> infection_probability = infection_rate;
+    for (auto& probability_vector : infection_probability)
+    {
+        for (double& probability : probability_vector)
+        {
+            probability = 1 - exp(-0.1*probability);
+        }
+    }
+    DiscreteSIS discrete_sis(edge_list, 1 - exp(-0.1*recovery_rate),
+            infection_probability);
+    run("DiscreteSIS", discrete_sis, 10*period);
+
+    return 0;
+}
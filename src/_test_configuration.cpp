@@ -0,0 +1,182 @@
+#include "ContinuousSIS.hpp"
+#include "ContinuousSIR.hpp"
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+using namespace schon;
+
+//access to the restoration of the history and to the state segments of the
+//groups, which are protected; the engines are used as they are, such that
+//their events are only called through their own translation units
+class ProcessAccess : public BaseContagion
+{
+public:
+    static void restore_from_history(BaseContagion& process)
+        {(process.*&ProcessAccess::get_configuration_from_history)();}
+    static Span<Membership> members(const BaseContagion& process,
+            Group group, NodeState node_state)
+        {return (process.*&ProcessAccess::group_state_members)(group,
+                node_state);}
+};
+
+//the members of each group are in the segment of their state
+bool consistent_groups(const BaseContagion& process)
+{
+    const BipartiteNetwork& network = process.get_network();
+    for (Group group : network.groups())
+    {
+        size_t number_of_members = 0;
+        for (unsigned int state = S; state < STATECOUNT; state++)
+        {
+            Span<Membership> members = ProcessAccess::members(process, group,
+                    NodeState(state));
+            for (Membership membership : members)
+            {
+                if (process.get_node_state_vector()[
+                        network.member(membership)] != state)
+                {
+                    return false;
+                }
+            }
+            number_of_members += members.size();
+        }
+        if (number_of_members != network.group_size(group))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//the states of the nodes, all S except those in [first, last) set to state
+vector<NodeState> expected_states(size_t number_of_nodes,
+        const vector<tuple<Node,Node,NodeState>>& ranges)
+{
+    vector<NodeState> states(number_of_nodes, S);
+    for (auto [first, last, state] : ranges)
+    {
+        fill(states.begin() + first, states.begin() + last, state);
+    }
+    return states;
+}
+
+unordered_set<Node> node_range(Node first, Node last)
+{
+    unordered_set<Node> node_set;
+    for (Node node = first; node < last; node++)
+    {
+        node_set.insert(node);
+    }
+    return node_set;
+}
+
+int main(int argc, const char *argv[])
+{
+    //each node belongs to 2 groups of size 5
+    size_t number_of_nodes = 1000;
+    EdgeList edge_list;
+    for (Node node = 0; node < number_of_nodes; node++)
+    {
+        edge_list.push_back(make_pair(node, node/5));
+        edge_list.push_back(make_pair(node,
+                    number_of_nodes/5 + ((node*7) % number_of_nodes)/5));
+    }
+    SharedNetwork network = make_shared<const BipartiteNetwork>(edge_list);
+    size_t number_of_groups = network->number_of_groups();
+    vector<vector<double>> infection_rate(6, vector<double>(6, 0.));
+    for (size_t n = 2; n < 6; n++)
+    {
+        for (size_t i = 0; i <= n; i++)
+        {
+            infection_rate[n][i] = 0.5*i;
+        }
+    }
+    vector<double> group_transmission_rate(number_of_groups, 1.);
+    int number_of_failures = 0;
+
+    //SIS: the configuration is restored in bulk when 700 nodes change state,
+    //and node by node when 10 do, with the same result
+    ContinuousSIS bulk(network, 1., infection_rate,
+            group_transmission_rate);
+    bulk.infect_node_set(node_range(0, 300));
+    bulk.initialize_history(1);
+    bulk.clear();
+    bulk.infect_node_set(node_range(500, 900));
+    ProcessAccess::restore_from_history(bulk);
+    ContinuousSIS diff(network, 1., infection_rate,
+            group_transmission_rate);
+    diff.infect_node_set(node_range(0, 300));
+    diff.initialize_history(1);
+    diff.infect_node_set(node_range(300, 310));
+    ProcessAccess::restore_from_history(diff);
+    vector<NodeState> states = expected_states(number_of_nodes,
+            {{0, 300, I}});
+    if (bulk.get_node_state_vector() != states
+            or diff.get_node_state_vector() != states
+            or not consistent_groups(bulk) or not consistent_groups(diff)
+            or fabs(bulk.get_lifetime() - diff.get_lifetime())
+            > 1e-12*diff.get_lifetime())
+    {
+        cout << "SIS: different restored configurations" << endl;
+        number_of_failures += 1;
+    }
+
+    //SIR: the infected nodes that are not in the configuration recover,
+    //and the recovered nodes stay recovered, however many nodes change
+    ContinuousSIR sir(network, 1., infection_rate,
+            group_transmission_rate);
+    sir.infect_node_set(node_range(0, 50));
+    sir.clear(); //the infected nodes recover
+    sir.infect_node_set(node_range(200, 400));
+    sir.initialize_history(1);
+    sir.infect_node_set(node_range(400, 900));
+    ProcessAccess::restore_from_history(sir);
+    states = expected_states(number_of_nodes,
+            {{0, 50, R}, {200, 400, I}, {400, 900, R}});
+    if (sir.get_node_state_vector() != states or not consistent_groups(sir))
+    {
+        cout << "SIR: recovered nodes lost by the restoration" << endl;
+        number_of_failures += 1;
+    }
+
+    //SIR: a configuration cannot be loaded over recovered nodes
+    try
+    {
+        sir.load_configuration(vector<Node>(1, 0));
+        cout << "SIR: configuration loaded over recovered nodes" << endl;
+        number_of_failures += 1;
+    }
+    catch (const runtime_error&)
+    {
+    }
+    if (sir.get_node_state_vector() != states)
+    {
+        cout << "SIR: rejected configuration changed the state" << endl;
+        number_of_failures += 1;
+    }
+
+    //SIS: the infected fraction of susceptible nodes is sampled directly,
+    //drawing the complement when most nodes are infected
+    for (double fraction : {0.25, 0.75})
+    {
+        ContinuousSIS sampled(network, 1., infection_rate,
+                group_transmission_rate);
+        sampled.infect_fraction(fraction);
+        size_t number_of_infected = count(
+                sampled.get_node_state_vector().begin(),
+                sampled.get_node_state_vector().end(), I);
+        if (number_of_infected != size_t(fraction*number_of_nodes)
+                or sampled.get_number_of_infected_nodes()
+                != number_of_infected or not consistent_groups(sampled))
+        {
+            cout << "SIS: wrong number of sampled nodes" << endl;
+            number_of_failures += 1;
+        }
+    }
+
+    cout << number_of_failures << " failures" << endl;
+    return number_of_failures == 0 ? 0 : 1;
+}
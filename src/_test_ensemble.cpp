@@ -0,0 +1,87 @@
+#include "Ensemble.hpp"
+#include "ContinuousSIS.hpp"
+#include <iostream>
+#include <stdexcept>
+
+using namespace std;
+using namespace schon;
+
+//merged measures of an ensemble of replicas seeded by their index
+vector<vector<double>> run_ensemble(SharedNetwork network,
+        size_t number_of_threads)
+{
+    size_t number_of_groups = network->number_of_groups();
+    vector<vector<double>> infection_rate(4, vector<double>(4, 0.));
+    for (size_t n = 2; n < 4; n++)
+    {
+        for (size_t i = 0; i <= n; i++)
+        {
+            infection_rate[n][i] = 0.5*i;
+        }
+    }
+    ProcessFactory factory = [&](size_t replica)
+    {
+        shared_ptr<ContinuousSIS> process = make_shared<ContinuousSIS>(
+                network, 1., infection_rate,
+                vector<double>(number_of_groups, 1.));
+        process->seed(42, replica);
+        process->measure_prevalence();
+        process->measure_marginal_infection_probability();
+        process->infect_fraction(0.2);
+        return process;
+    };
+    Ensemble ensemble(factory, 16, number_of_threads);
+    ensemble.run(5., 20., 1.);
+    const vector<shared_ptr<Measure>>& measure_vector =
+        ensemble.get_measure_vector();
+    return {dynamic_pointer_cast<Prevalence>(measure_vector[0])->get_result(),
+        dynamic_pointer_cast<MarginalInfectionProbability>(
+                measure_vector[1])->get_result()};
+}
+
+int main(int argc, const char *argv[])
+{
+    //each node belongs to 2 groups of size 3
+    size_t number_of_nodes = 3000;
+    EdgeList edge_list;
+    for (Node node = 0; node < number_of_nodes; node++)
+    {
+        edge_list.push_back(make_pair(node, node/3));
+        edge_list.push_back(make_pair(node,
+                    number_of_nodes/3 + ((node*7) % number_of_nodes)/3));
+    }
+    SharedNetwork network = make_shared<const BipartiteNetwork>(edge_list);
+
+    //the merged measures do not depend on the number of threads
+    int number_of_failures = 0;
+    vector<vector<double>> reference = run_ensemble(network, 1);
+    if (reference[0].empty())
+    {
+        cout << "no measure" << endl;
+        number_of_failures += 1;
+    }
+    for (size_t number_of_threads : {2, 4, 7})
+    {
+        if (run_ensemble(network, number_of_threads) != reference)
+        {
+            cout << "different measures with " << number_of_threads
+                << " threads" << endl;
+            number_of_failures += 1;
+        }
+    }
+
+    //measures on networks of different sizes cannot be merged
+    MarginalInfectionProbability marginal(10);
+    try
+    {
+        marginal.merge(MarginalInfectionProbability(11));
+        cout << "merge of measures of different sizes" << endl;
+        number_of_failures += 1;
+    }
+    catch (const invalid_argument&)
+    {
+    }
+
+    cout << number_of_failures << " failures" << endl;
+    return number_of_failures == 0 ? 0 : 1;
+}
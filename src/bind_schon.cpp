@@ -24,7 +24,10 @@
 
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 #include <PowerlawGroupSIS.hpp>
+#include <GenericGroupSIS.hpp>
 #include <BaseContagion.hpp>
 #include <ContinuousSIS.hpp>
 #include <ContinuousSIR.hpp>
@@ -34,32 +37,299 @@
 #include <Prevalence.hpp>
 #include <InfectiousSet.hpp>
 #include <Time.hpp>
+#include <Ensemble.hpp>
+#include <limits>
+#include <optional>
+#include <string>
+#include <unordered_set>
 
 using namespace std;
 using namespace schon;
 
 namespace py = pybind11;
 
+//contiguous array of node or group labels, converted only if needed
+typedef py::array_t<Node, py::array::c_style | py::array::forcecast>
+    LabelArray;
+
+//labels of an array of any numeric dtype, checked to be integers in the
+//range of Node before the conversion, which would wrap them silently
+LabelArray checked_labels(const py::array& array)
+{
+    char kind = array.dtype().kind();
+    if (kind != 'i' and kind != 'u' and kind != 'f')
+    {
+        throw py::type_error("the labels must be integers");
+    }
+    bool in_range = kind == 'u' and array.itemsize() <= sizeof(Node);
+    if (not in_range and array.size() > 0)
+    {
+        py::module numpy = py::module::import("numpy");
+        if (kind == 'f' and not numpy.attr("array_equal")(array,
+                    numpy.attr("floor")(array)).cast<bool>())
+        {
+            throw py::value_error("the labels must be integers");
+        }
+        double min = array.attr("min")().cast<double>();
+        double max = array.attr("max")().cast<double>();
+        if (not (min >= 0 and max <= numeric_limits<Node>::max()))
+        {
+            throw py::value_error("the labels must be between 0 and "
+                    + to_string(numeric_limits<Node>::max()));
+        }
+    }
+    return LabelArray(array);
+}
+
+//rate bounds of the event set, computed exactly from the rates when absent
+typedef optional<pair<double,double>> RateBounds;
+
+//network built straight from the memory of an (E,2) array of edges
+shared_ptr<BipartiteNetwork> make_network(const py::array& edge_labels)
+{
+    if (edge_labels.ndim() != 2 or edge_labels.shape(1) != 2)
+    {
+        throw invalid_argument("the edge array must be of shape (E,2)");
+    }
+    LabelArray edge_array = checked_labels(edge_labels);
+    const Node* data = edge_array.data();
+    size_t number_of_edges = edge_array.shape(0);
+    py::gil_scoped_release release;
+    return make_shared<BipartiteNetwork>(data, data+1, number_of_edges, 2);
+}
+
+//network built straight from the memory of two arrays of nodes and groups
+shared_ptr<BipartiteNetwork> make_network(const py::array& node_labels,
+        const py::array& group_labels)
+{
+    if (node_labels.ndim() != 1 or group_labels.ndim() != 1
+            or node_labels.size() != group_labels.size())
+    {
+        throw invalid_argument(
+                "the node and group arrays must be 1D and of the same size");
+    }
+    LabelArray node_array = checked_labels(node_labels);
+    LabelArray group_array = checked_labels(group_labels);
+    const Node* nodes = node_array.data();
+    const Group* groups = group_array.data();
+    size_t number_of_edges = node_array.size();
+    py::gil_scoped_release release;
+    return make_shared<BipartiteNetwork>(nodes, groups, number_of_edges);
+}
+
+//group SIS process with a given rate policy, with exact rate bounds if none
+//are given
+template <class RatePolicy>
+GenericGroupSIS<RatePolicy>* new_group_sis(SharedNetwork network,
+        double scale_recovery, const RatePolicy& rate,
+        const RateBounds& rate_bounds)
+{
+    return rate_bounds ?
+        new GenericGroupSIS<RatePolicy>(network, scale_recovery, rate,
+                *rate_bounds)
+        : new GenericGroupSIS<RatePolicy>(network, scale_recovery, rate);
+}
+
+//power law SIS process, with the rate inlined for the shapes 1 and 2 and
+//tabulated for the other shapes
+PowerlawGroupSIS* new_powerlaw_group_sis(SharedNetwork network,
+        double scale_recovery, double scale_infection, double shape_infection,
+        const RateBounds& rate_bounds)
+{
+    return rate_bounds ?
+        new PowerlawGroupSIS(network, scale_recovery, scale_infection,
+                shape_infection, *rate_bounds)
+        : new PowerlawGroupSIS(network, scale_recovery, scale_infection,
+                shape_infection);
+}
+
+//power law SIS process, with the kernel specialized at compile time for
+//the integer shapes
+py::object make_powerlaw_group_sis(SharedNetwork network,
+        double scale_recovery, double scale_infection, double shape_infection,
+        const RateBounds& rate_bounds)
+{
+    if (shape_infection == 1.)
+    {
+        return py::cast(new_group_sis(network, scale_recovery,
+                    LinearRate(scale_infection), rate_bounds),
+                py::return_value_policy::take_ownership);
+    }
+    if (shape_infection == 2.)
+    {
+        return py::cast(new_group_sis(network, scale_recovery,
+                    QuadraticRate(scale_infection), rate_bounds),
+                py::return_value_policy::take_ownership);
+    }
+    return py::cast(new_powerlaw_group_sis(network, scale_recovery,
+                scale_infection, shape_infection, rate_bounds),
+            py::return_value_policy::take_ownership);
+}
+
+//the GIL is released while a process runs, except for a group SIS process
+//calling its infection rate on each event: the rate may be a Python
+//function, which would take the GIL back on every call
+bool releases_gil(const BaseContagion& process)
+{
+    const GroupSIS* group_sis = dynamic_cast<const GroupSIS*>(&process);
+    return group_sis == nullptr or not group_sis->calls_infection_rate();
+}
+
+//method of a process called without the GIL when the process allows it
+template <class... Args>
+auto without_gil(void (BaseContagion::*method)(Args...))
+{
+    return [method](BaseContagion& process, Args... args)
+    {
+        optional<py::gil_scoped_release> release;
+        if (releases_gil(process))
+        {
+            release.emplace();
+        }
+        (process.*method)(args...);
+    };
+}
+
+//read-only NumPy view of a snapshot of a measure result from an offset,
+//sharing its memory; the capsule keeps the buffer alive, and the measure
+//never moves nor modifies the values of a snapshot
+py::array_t<double> shared_array(const ResultBuffer::Snapshot& snapshot,
+        size_t offset = 0)
+{
+    offset = min(offset, snapshot.values.size());
+    auto owner = new shared_ptr<const vector<double>>(snapshot.owner);
+    py::capsule base(owner, [](void* pointer)
+        {delete static_cast<shared_ptr<const vector<double>>*>(pointer);});
+    py::array_t<double> array(snapshot.values.size() - offset,
+            snapshot.values.begin() + offset, base);
+    array.attr("setflags")(py::arg("write") = false);
+    return array;
+}
+
 
 PYBIND11_MODULE(_schon, m)
 {
-    /* ===========
-     * Base class
-     * ===========*/
+    /* =============
+     * Network class
+     * =============*/
 
-    py::class_<BaseContagion>(m, "BaseContagion")
+    py::class_<BipartiteNetwork, shared_ptr<BipartiteNetwork>>(m,
+            "BipartiteNetwork")
+
+        .def(py::init([](const py::array& edge_array)
+            {return make_network(edge_array);}), R"pbdoc(
+            Constructor of the class BipartiteNetwork from an edge array,
+            read without conversion if it is C-contiguous with dtype uint32.
+            Arrays of other integer or float dtypes are converted, after
+            checking that the labels are integers between 0 and 2^32-1;
+            a ValueError is raised otherwise. Lists are read as edge lists.
+
+            Args:
+               edge_list: Array of shape (E,2) of (node,group) edges.
+            )pbdoc", py::arg("edge_list"))
+
+        .def(py::init([](const py::array& node_array,
+                        const py::array& group_array)
+            {return make_network(node_array, group_array);}), R"pbdoc(
+            Constructor of the class BipartiteNetwork from two arrays, the
+            i-th edge being (nodes[i], groups[i]).
+
+            Args:
+               nodes: Array of the node of each edge.
+               groups: Array of the group of each edge.
+            )pbdoc", py::arg("nodes"), py::arg("groups"))
 
         .def(py::init<EdgeList>(), R"pbdoc(
-            Default constructor of the class BaseContagion.
+            Default constructor of the class BipartiteNetwork. A network can be
+            shared by many processes, to be built only once.
 
             Args:
                edge_list: Edge list for the network structure.
             )pbdoc", py::arg("edge_list"))
 
+        .def("size", &BipartiteNetwork::size, R"pbdoc(
+            Returns the number of nodes.
+            )pbdoc")
+
+        .def("number_of_nodes", &BipartiteNetwork::number_of_nodes, R"pbdoc(
+            Returns the number of nodes.
+            )pbdoc")
+
+        .def("number_of_groups", &BipartiteNetwork::number_of_groups, R"pbdoc(
+            Returns the number of groups.
+            )pbdoc")
+
+        .def("membership", &BipartiteNetwork::membership, R"pbdoc(
+            Returns the number of groups of a node.
+
+            Args:
+               node: Node label.
+            )pbdoc", py::arg("node"))
+
+        .def("group_size", &BipartiteNetwork::group_size, R"pbdoc(
+            Returns the number of nodes in a group.
+
+            Args:
+               group: Group label.
+            )pbdoc", py::arg("group"))
+
+        .def("adjacent_groups", [](const BipartiteNetwork& network, Node node)
+            {Span<Group> groups = network.adjacent_groups(node);
+                return vector<Group>(groups.begin(), groups.end());}, R"pbdoc(
+            Returns the groups of a node.
+
+            Args:
+               node: Node label.
+            )pbdoc", py::arg("node"))
+
+        .def("group_members", [](const BipartiteNetwork& network, Group group)
+            {Span<Node> members = network.group_members(group);
+                return vector<Node>(members.begin(), members.end());}, R"pbdoc(
+            Returns the nodes of a group.
+
+            Args:
+               group: Group label.
+            )pbdoc", py::arg("group"))
+
+        .def("min_membership", &BipartiteNetwork::min_membership, R"pbdoc(
+            Returns the minimal number of groups of a node.
+            )pbdoc")
+
+        .def("max_membership", &BipartiteNetwork::max_membership, R"pbdoc(
+            Returns the maximal number of groups of a node.
+            )pbdoc")
+
+        .def("min_group_size", &BipartiteNetwork::min_group_size, R"pbdoc(
+            Returns the minimal group size.
+            )pbdoc")
+
+        .def("max_group_size", &BipartiteNetwork::max_group_size, R"pbdoc(
+            Returns the maximal group size.
+            )pbdoc")
+
+        .def("number_of_edges", &BipartiteNetwork::number_of_edges, R"pbdoc(
+            Returns the number of node-group memberships.
+            )pbdoc");
+
+
+    /* ===========
+     * Base class
+     * ===========*/
+
+    py::class_<BaseContagion>(m, "BaseContagion")
+
         .def("size", &BaseContagion::size, R"pbdoc(
             Returns the number of nodes.
             )pbdoc")
 
+        //the bound methods of the network are all const, so the cast to the
+        //holder of the class does not let Python modify a shared network
+        .def("get_network", [](const BaseContagion& process)
+            {return const_pointer_cast<BipartiteNetwork>(
+                    process.get_shared_network());}, R"pbdoc(
+            Returns the network, which can be shared with other processes.
+            )pbdoc")
+
         .def("get_state_vector", &BaseContagion::get_node_state_vector, R"pbdoc(
             Returns the vector of state for each node.
             )pbdoc")
@@ -73,37 +343,50 @@ PYBIND11_MODULE(_schon, m)
             Returns the number of infected nodes.
             )pbdoc")
 
-        .def("infect_fraction", &BaseContagion::infect_fraction, R"pbdoc(
+        .def("infect_fraction", without_gil(&BaseContagion::infect_fraction),
+                R"pbdoc(
             Infect a fraction of the nodes.
 
             Args:
                fraction: Fraction to be infected.
             )pbdoc", py::arg("fraction"))
 
-        .def("infect_node_set", &BaseContagion::infect_node_set, R"pbdoc(
+        .def("infect_node_set", without_gil(&BaseContagion::infect_node_set),
+                R"pbdoc(
             Infect the nodes in the node set.
 
             Args:
                node_set: Set of nodes to infect.
             )pbdoc", py::arg("node_set"))
 
-        .def("clear", &BaseContagion::clear, R"pbdoc(
+        .def("load_configuration", without_gil(
+                static_cast<void (BaseContagion::*)(const vector<Node>&)>(
+                    &BaseContagion::load_configuration)), R"pbdoc(
+            Replace the current configuration, rebuilding all the rates in a
+            single pass. All the nodes must be susceptible or infected.
+
+            Args:
+               infected_node_list: List of the nodes to be infected, all
+                                   other nodes become susceptible.
+            )pbdoc", py::arg("infected_node_list"))
+
+        .def("clear", without_gil(&BaseContagion::clear), R"pbdoc(
             Recover all nodes.
             )pbdoc")
 
-        .def("reset", &BaseContagion::reset, R"pbdoc(
+        .def("reset", without_gil(&BaseContagion::reset), R"pbdoc(
             Reset time and system, with all susceptible nodes, remove history.
             )pbdoc")
 
-        .def("initialize_history", &BaseContagion::initialize_history,
-                R"pbdoc(
+        .def("initialize_history",
+                without_gil(&BaseContagion::initialize_history), R"pbdoc(
             Fill the history with the current state.
 
             Args:
                number_of_states: Number of state copies.
             )pbdoc", py::arg("number_of_states")=100)
 
-        .def("seed", &BaseContagion::seed,
+        .def("seed", py::overload_cast<unsigned int>(&BaseContagion::seed),
                 R"pbdoc(
             Seed the RNG.
 
@@ -111,8 +394,18 @@ PYBIND11_MODULE(_schon, m)
                seed: seed for the RNG.
             )pbdoc", py::arg("seed"))
 
-        .def("evolve", &BaseContagion::evolve,
-                R"pbdoc(
+        .def("seed", py::overload_cast<unsigned int, unsigned long long>(
+                    &BaseContagion::seed), R"pbdoc(
+            Seed the RNG and select its stream. Processes with the same seed
+            but different streams produce independent sequences, e.g. for
+            replicas run in parallel.
+
+            Args:
+               seed: seed for the RNG.
+               stream: stream of the RNG.
+            )pbdoc", py::arg("seed"), py::arg("stream"))
+
+        .def("evolve", without_gil(&BaseContagion::evolve), R"pbdoc(
             Let the system evolve over a period of time.
 
             Args:
@@ -164,27 +457,132 @@ PYBIND11_MODULE(_schon, m)
 
     py::class_<GroupSIS, BaseContagion>(m, "GroupSIS")
 
-        .def(py::init<EdgeList, double,
-                const function<double(size_t,size_t)>&,
-                const pair<double,double>&>(), R"pbdoc(
+        .def(py::init([](const py::array& edge_array,
+                        double recovery_rate,
+                        const function<double(size_t,size_t)>& infection_rate,
+                        const RateBounds& rate_bounds,
+                        bool tabulate)
+            {return rate_bounds ?
+                new GroupSIS(make_network(edge_array), recovery_rate,
+                    infection_rate, *rate_bounds, tabulate)
+                : new GroupSIS(make_network(edge_array), recovery_rate,
+                    infection_rate, tabulate);}), R"pbdoc(
+            Constructor of the class GroupSIS from an edge array.
+
+            Args:
+               edge_list: Array of shape (E,2) of (node,group) edges.
+               recovery_rate: Double for the recovery rate
+               infection_rate: Function for the recovery rate
+               rate_bounds: Initial guess of the rate lower and upper
+                            bounds, extended if needed; computed exactly
+                            from the rates if None.
+               tabulate: Bool, if true the infection rate is evaluated once
+                         for each group size and number of infected, instead
+                         of being called on each event; off by default, as
+                         the table evaluates the function for every group
+                         size present and every number of infected. Without
+                         the table, the process holds the GIL while it runs.
+            )pbdoc", py::arg("edge_list"),
+                py::arg("recovery_rate"),
+                py::arg("infection_rate"),
+                py::arg("rate_bounds")=py::none(),
+                py::arg("tabulate")=false)
+
+        .def(py::init([](const EdgeList& edge_list,
+                        double recovery_rate,
+                        const function<double(size_t,size_t)>& infection_rate,
+                        const RateBounds& rate_bounds,
+                        bool tabulate)
+            {return rate_bounds ?
+                new GroupSIS(edge_list, recovery_rate, infection_rate,
+                    *rate_bounds, tabulate)
+                : new GroupSIS(edge_list, recovery_rate, infection_rate,
+                    tabulate);}), R"pbdoc(
             Default constructor of the class GroupSIS.
 
             Args:
                edge_list: Edge list for the network structure.
                recovery_rate: Double for the recovery rate
                infection_rate: Function for the recovery rate
-               rate_bounds: Rate lower and upper bounds.
+               rate_bounds: Initial guess of the rate lower and upper
+                            bounds, extended if needed; computed exactly
+                            from the rates if None.
+               tabulate: Bool, if true the infection rate is evaluated once
+                         for each group size and number of infected, instead
+                         of being called on each event; off by default, as
+                         the table evaluates the function for every group
+                         size present and every number of infected. Without
+                         the table, the process holds the GIL while it runs.
             )pbdoc", py::arg("edge_list"),
                 py::arg("recovery_rate"),
                 py::arg("infection_rate"),
-                py::arg("rate_bounds"))
+                py::arg("rate_bounds")=py::none(),
+                py::arg("tabulate")=false)
+
+        .def(py::init([](shared_ptr<BipartiteNetwork> network,
+                        double recovery_rate,
+                        const function<double(size_t,size_t)>& infection_rate,
+                        const RateBounds& rate_bounds,
+                        bool tabulate)
+            {return rate_bounds ?
+                new GroupSIS(network, recovery_rate, infection_rate,
+                    *rate_bounds, tabulate)
+                : new GroupSIS(network, recovery_rate, infection_rate,
+                    tabulate);}), R"pbdoc(
+            Constructor of the class GroupSIS from a shared network.
+
+            Args:
+               network: BipartiteNetwork for the network structure.
+               recovery_rate: Double for the recovery rate
+               infection_rate: Function for the recovery rate
+               rate_bounds: Initial guess of the rate lower and upper
+                            bounds, extended if needed; computed exactly
+                            from the rates if None.
+               tabulate: Bool, if true the infection rate is evaluated once
+                         for each group size and number of infected, instead
+                         of being called on each event; off by default, as
+                         the table evaluates the function for every group
+                         size present and every number of infected. Without
+                         the table, the process holds the GIL while it runs.
+            )pbdoc", py::arg("network").none(false),
+                py::arg("recovery_rate"),
+                py::arg("infection_rate"),
+                py::arg("rate_bounds")=py::none(),
+                py::arg("tabulate")=false)
 
         .def("get_lifetime", &GroupSIS::get_lifetime, R"pbdoc(
             Returns the lifetime for the current state.
+            )pbdoc")
+
+        .def("is_tabulated", &GroupSIS::is_tabulated, R"pbdoc(
+            Returns true if the infection rate is looked up in a table.
+            )pbdoc")
+
+        .def("rate_table_footprint", &GroupSIS::rate_table_footprint,
+                R"pbdoc(
+            Returns the memory used by the infection rate table, in bytes.
             )pbdoc");
 
     py::class_<ContinuousSIS, BaseContagion>(m, "ContinuousSIS")
 
+        .def(py::init([](const py::array& edge_array,
+                        double recovery_rate,
+                        const vector<vector<double>>& infection_rate,
+                        const vector<double>& group_transmission_rate)
+            {return new ContinuousSIS(make_network(edge_array), recovery_rate,
+                    infection_rate, group_transmission_rate);}), R"pbdoc(
+            Constructor of the class ContinuousSIS from an edge array.
+
+            Args:
+               edge_list: Array of shape (E,2) of (node,group) edges.
+               recovery_rate: Double for the recovery rate
+               infection_rate: Matrix of infection rate per node in groups
+               group_transmission_rate: Vector of transmission rate per group
+            )pbdoc", py::arg("edge_list"),
+                py::arg("recovery_rate"),
+                py::arg("infection_rate"),
+                py::arg("group_transmission_rate"))
+
         .def(py::init<EdgeList&, double,
                 const vector<vector<double>>&,
                 const vector<double>&>(), R"pbdoc(
@@ -200,6 +598,24 @@ PYBIND11_MODULE(_schon, m)
                 py::arg("infection_rate"),
                 py::arg("group_transmission_rate"))
 
+        .def(py::init([](shared_ptr<BipartiteNetwork> network,
+                        double recovery_rate,
+                        const vector<vector<double>>& infection_rate,
+                        const vector<double>& group_transmission_rate)
+            {return new ContinuousSIS(network, recovery_rate, infection_rate,
+                    group_transmission_rate);}), R"pbdoc(
+            Constructor of the class ContinuousSIS from a shared network.
+
+            Args:
+               network: BipartiteNetwork for the network structure.
+               recovery_rate: Double for the recovery rate
+               infection_rate: Matrix of infection rate per node in groups
+               group_transmission_rate: Vector of transmission rate per group
+            )pbdoc", py::arg("network").none(false),
+                py::arg("recovery_rate"),
+                py::arg("infection_rate"),
+                py::arg("group_transmission_rate"))
+
         .def("get_lifetime", &ContinuousSIS::get_lifetime, R"pbdoc(
             Returns the lifetime for the current state.
             )pbdoc");
@@ -207,6 +623,24 @@ PYBIND11_MODULE(_schon, m)
 
     py::class_<ContinuousSIR, BaseContagion>(m, "ContinuousSIR")
 
+        .def(py::init([](const py::array& edge_array,
+                        double recovery_rate,
+                        const vector<vector<double>>& infection_rate,
+                        const vector<double>& group_transmission_rate)
+            {return new ContinuousSIR(make_network(edge_array), recovery_rate,
+                    infection_rate, group_transmission_rate);}), R"pbdoc(
+            Constructor of the class ContinuousSIR from an edge array.
+
+            Args:
+               edge_list: Array of shape (E,2) of (node,group) edges.
+               recovery_rate: Double for the recovery rate
+               infection_rate: Matrix of infection rate per node in groups
+               group_transmission_rate: Vector of transmission rate per group
+            )pbdoc", py::arg("edge_list"),
+                py::arg("recovery_rate"),
+                py::arg("infection_rate"),
+                py::arg("group_transmission_rate"))
+
         .def(py::init<EdgeList&, double,
                 const vector<vector<double>>&,
                 const vector<double>&>(), R"pbdoc(
@@ -222,6 +656,24 @@ PYBIND11_MODULE(_schon, m)
                 py::arg("infection_rate"),
                 py::arg("group_transmission_rate"))
 
+        .def(py::init([](shared_ptr<BipartiteNetwork> network,
+                        double recovery_rate,
+                        const vector<vector<double>>& infection_rate,
+                        const vector<double>& group_transmission_rate)
+            {return new ContinuousSIR(network, recovery_rate, infection_rate,
+                    group_transmission_rate);}), R"pbdoc(
+            Constructor of the class ContinuousSIR from a shared network.
+
+            Args:
+               network: BipartiteNetwork for the network structure.
+               recovery_rate: Double for the recovery rate
+               infection_rate: Matrix of infection rate per node in groups
+               group_transmission_rate: Vector of transmission rate per group
+            )pbdoc", py::arg("network").none(false),
+                py::arg("recovery_rate"),
+                py::arg("infection_rate"),
+                py::arg("group_transmission_rate"))
+
         .def("get_lifetime", &ContinuousSIR::get_lifetime, R"pbdoc(
             Returns the lifetime for the current state.
             )pbdoc");
@@ -229,24 +681,401 @@ PYBIND11_MODULE(_schon, m)
 
     py::class_<PowerlawGroupSIS, GroupSIS>(m, "PowerlawGroupSIS")
 
-        .def(py::init<EdgeList, double, double, double,
-                const pair<double,double>&>(), R"pbdoc(
+        .def(py::init([](const py::array& edge_array,
+                        double scale_recovery, double scale_infection,
+                        double shape_infection,
+                        const RateBounds& rate_bounds)
+            {return new_powerlaw_group_sis(make_network(edge_array),
+                    scale_recovery, scale_infection, shape_infection,
+                    rate_bounds);}), R"pbdoc(
+            Constructor of the class PowerlawGroupSIS from an edge array.
+
+            Args:
+               edge_list: Array of shape (E,2) of (node,group) edges.
+               scale_recovery: Recovery rate for infected nodes
+               scale_infection: Infection rate factor.
+               shape_infection: Power-law exponent for infection; the
+                                shapes 1 and 2 are computed inline, the
+                                others are tabulated.
+               rate_bounds: Initial guess of the rate lower and upper
+                            bounds, extended if needed; computed exactly
+                            from the rates if None.
+            )pbdoc", py::arg("edge_list"),
+                py::arg("scale_recovery"),
+                py::arg("scale_infection"),
+                py::arg("shape_infection"),
+                py::arg("rate_bounds")=py::none())
+
+        .def(py::init([](const EdgeList& edge_list,
+                        double scale_recovery, double scale_infection,
+                        double shape_infection,
+                        const RateBounds& rate_bounds)
+            {return new_powerlaw_group_sis(
+                    make_shared<const BipartiteNetwork>(edge_list),
+                    scale_recovery, scale_infection, shape_infection,
+                    rate_bounds);}), R"pbdoc(
             Default constructor of the class PowerlawGroupSIS.
 
             Args:
                edge_list: Edge list for the network structure.
                scale_recovery: Recovery rate for infected nodes
                scale_infection: Infection rate factor.
+               shape_infection: Power-law exponent for infection; the
+                                shapes 1 and 2 are computed inline, the
+                                others are tabulated.
+               rate_bounds: Initial guess of the rate lower and upper
+                            bounds, extended if needed; computed exactly
+                            from the rates if None.
+            )pbdoc", py::arg("edge_list"),
+                py::arg("scale_recovery"),
+                py::arg("scale_infection"),
+                py::arg("shape_infection"),
+                py::arg("rate_bounds")=py::none())
+
+        .def(py::init([](shared_ptr<BipartiteNetwork> network,
+                        double scale_recovery, double scale_infection,
+                        double shape_infection,
+                        const RateBounds& rate_bounds)
+            {return new_powerlaw_group_sis(network, scale_recovery,
+                    scale_infection, shape_infection, rate_bounds);}),
+            R"pbdoc(
+            Constructor of the class PowerlawGroupSIS from a shared network.
+
+            Args:
+               network: BipartiteNetwork for the network structure.
+               scale_recovery: Recovery rate for infected nodes
+               scale_infection: Infection rate factor.
+               shape_infection: Power-law exponent for infection; the
+                                shapes 1 and 2 are computed inline, the
+                                others are tabulated.
+               rate_bounds: Initial guess of the rate lower and upper
+                            bounds, extended if needed; computed exactly
+                            from the rates if None.
+            )pbdoc", py::arg("network").none(false),
+                py::arg("scale_recovery"),
+                py::arg("scale_infection"),
+                py::arg("shape_infection"),
+                py::arg("rate_bounds")=py::none());
+
+    py::class_<LinearGroupSIS, BaseContagion>(m, "LinearGroupSIS")
+
+        .def(py::init([](const py::array& edge_array,
+                        double scale_recovery, double scale_infection,
+                        const RateBounds& rate_bounds)
+            {return new_group_sis(make_network(edge_array), scale_recovery,
+                    LinearRate(scale_infection), rate_bounds);}), R"pbdoc(
+            Constructor of the class LinearGroupSIS from an edge array, with
+            infection rate scale_infection*(n-i)*i in a group of size n with
+            i infected.
+
+            Args:
+               edge_list: Array of shape (E,2) of (node,group) edges.
+               scale_recovery: Recovery rate for infected nodes
+               scale_infection: Infection rate factor.
+               rate_bounds: Initial guess of the rate lower and upper
+                            bounds, extended if needed; computed exactly
+                            from the rates if None.
+            )pbdoc", py::arg("edge_list"),
+                py::arg("scale_recovery"),
+                py::arg("scale_infection"),
+                py::arg("rate_bounds")=py::none())
+
+        .def(py::init([](const EdgeList& edge_list,
+                        double scale_recovery, double scale_infection,
+                        const RateBounds& rate_bounds)
+            {return new_group_sis(
+                    make_shared<const BipartiteNetwork>(edge_list),
+                    scale_recovery, LinearRate(scale_infection),
+                    rate_bounds);}), R"pbdoc(
+            Default constructor of the class LinearGroupSIS, with infection
+            rate scale_infection*(n-i)*i in a group of size n with i
+            infected.
+
+            Args:
+               edge_list: Edge list for the network structure.
+               scale_recovery: Recovery rate for infected nodes
+               scale_infection: Infection rate factor.
+               rate_bounds: Initial guess of the rate lower and upper
+                            bounds, extended if needed; computed exactly
+                            from the rates if None.
+            )pbdoc", py::arg("edge_list"),
+                py::arg("scale_recovery"),
+                py::arg("scale_infection"),
+                py::arg("rate_bounds")=py::none())
+
+        .def(py::init([](shared_ptr<BipartiteNetwork> network,
+                        double scale_recovery, double scale_infection,
+                        const RateBounds& rate_bounds)
+            {return new_group_sis(network, scale_recovery,
+                    LinearRate(scale_infection), rate_bounds);}), R"pbdoc(
+            Constructor of the class LinearGroupSIS from a shared network,
+            with infection rate scale_infection*(n-i)*i in a group of size n
+            with i infected.
+
+            Args:
+               network: BipartiteNetwork for the network structure.
+               scale_recovery: Recovery rate for infected nodes
+               scale_infection: Infection rate factor.
+               rate_bounds: Initial guess of the rate lower and upper
+                            bounds, extended if needed; computed exactly
+                            from the rates if None.
+            )pbdoc", py::arg("network").none(false),
+                py::arg("scale_recovery"),
+                py::arg("scale_infection"),
+                py::arg("rate_bounds")=py::none())
+
+        .def("get_lifetime", &LinearGroupSIS::get_lifetime, R"pbdoc(
+            Returns the lifetime for the current state.
+            )pbdoc");
+
+    py::class_<QuadraticGroupSIS, BaseContagion>(m, "QuadraticGroupSIS")
+
+        .def(py::init([](const py::array& edge_array,
+                        double scale_recovery, double scale_infection,
+                        const RateBounds& rate_bounds)
+            {return new_group_sis(make_network(edge_array), scale_recovery,
+                    QuadraticRate(scale_infection), rate_bounds);}), R"pbdoc(
+            Constructor of the class QuadraticGroupSIS from an edge array,
+            with infection rate scale_infection*(n-i)*i^2 in a group of size
+            n with i infected.
+
+            Args:
+               edge_list: Array of shape (E,2) of (node,group) edges.
+               scale_recovery: Recovery rate for infected nodes
+               scale_infection: Infection rate factor.
+               rate_bounds: Initial guess of the rate lower and upper
+                            bounds, extended if needed; computed exactly
+                            from the rates if None.
+            )pbdoc", py::arg("edge_list"),
+                py::arg("scale_recovery"),
+                py::arg("scale_infection"),
+                py::arg("rate_bounds")=py::none())
+
+        .def(py::init([](const EdgeList& edge_list,
+                        double scale_recovery, double scale_infection,
+                        const RateBounds& rate_bounds)
+            {return new_group_sis(
+                    make_shared<const BipartiteNetwork>(edge_list),
+                    scale_recovery, QuadraticRate(scale_infection),
+                    rate_bounds);}), R"pbdoc(
+            Default constructor of the class QuadraticGroupSIS, with
+            infection rate scale_infection*(n-i)*i^2 in a group of size n
+            with i infected.
+
+            Args:
+               edge_list: Edge list for the network structure.
+               scale_recovery: Recovery rate for infected nodes
+               scale_infection: Infection rate factor.
+               rate_bounds: Initial guess of the rate lower and upper
+                            bounds, extended if needed; computed exactly
+                            from the rates if None.
+            )pbdoc", py::arg("edge_list"),
+                py::arg("scale_recovery"),
+                py::arg("scale_infection"),
+                py::arg("rate_bounds")=py::none())
+
+        .def(py::init([](shared_ptr<BipartiteNetwork> network,
+                        double scale_recovery, double scale_infection,
+                        const RateBounds& rate_bounds)
+            {return new_group_sis(network, scale_recovery,
+                    QuadraticRate(scale_infection), rate_bounds);}), R"pbdoc(
+            Constructor of the class QuadraticGroupSIS from a shared
+            network, with infection rate scale_infection*(n-i)*i^2 in a
+            group of size n with i infected.
+
+            Args:
+               network: BipartiteNetwork for the network structure.
+               scale_recovery: Recovery rate for infected nodes
+               scale_infection: Infection rate factor.
+               rate_bounds: Initial guess of the rate lower and upper
+                            bounds, extended if needed; computed exactly
+                            from the rates if None.
+            )pbdoc", py::arg("network").none(false),
+                py::arg("scale_recovery"),
+                py::arg("scale_infection"),
+                py::arg("rate_bounds")=py::none())
+
+        .def("get_lifetime", &QuadraticGroupSIS::get_lifetime, R"pbdoc(
+            Returns the lifetime for the current state.
+            )pbdoc");
+
+    py::class_<ThresholdGroupSIS, BaseContagion>(m, "ThresholdGroupSIS")
+
+        .def(py::init([](const py::array& edge_array,
+                        double scale_recovery, double scale_infection,
+                        size_t threshold,
+                        const RateBounds& rate_bounds)
+            {return new_group_sis(make_network(edge_array), scale_recovery,
+                    ThresholdRate(scale_infection, threshold),
+                    rate_bounds);}), R"pbdoc(
+            Constructor of the class ThresholdGroupSIS from an edge array,
+            with infection rate scale_infection*(n-i) in a group of size n
+            with at least threshold infected, and 0 otherwise.
+
+            Args:
+               edge_list: Array of shape (E,2) of (node,group) edges.
+               scale_recovery: Recovery rate for infected nodes
+               scale_infection: Infection rate factor.
+               threshold: Minimal number of infected in a group.
+               rate_bounds: Initial guess of the rate lower and upper
+                            bounds, extended if needed; computed exactly
+                            from the rates if None.
+            )pbdoc", py::arg("edge_list"),
+                py::arg("scale_recovery"),
+                py::arg("scale_infection"),
+                py::arg("threshold"),
+                py::arg("rate_bounds")=py::none())
+
+        .def(py::init([](const EdgeList& edge_list,
+                        double scale_recovery, double scale_infection,
+                        size_t threshold,
+                        const RateBounds& rate_bounds)
+            {return new_group_sis(
+                    make_shared<const BipartiteNetwork>(edge_list),
+                    scale_recovery, ThresholdRate(scale_infection, threshold),
+                    rate_bounds);}), R"pbdoc(
+            Default constructor of the class ThresholdGroupSIS, with
+            infection rate scale_infection*(n-i) in a group of size n with at
+            least threshold infected, and 0 otherwise.
+
+            Args:
+               edge_list: Edge list for the network structure.
+               scale_recovery: Recovery rate for infected nodes
+               scale_infection: Infection rate factor.
+               threshold: Minimal number of infected in a group.
+               rate_bounds: Initial guess of the rate lower and upper
+                            bounds, extended if needed; computed exactly
+                            from the rates if None.
+            )pbdoc", py::arg("edge_list"),
+                py::arg("scale_recovery"),
+                py::arg("scale_infection"),
+                py::arg("threshold"),
+                py::arg("rate_bounds")=py::none())
+
+        .def(py::init([](shared_ptr<BipartiteNetwork> network,
+                        double scale_recovery, double scale_infection,
+                        size_t threshold,
+                        const RateBounds& rate_bounds)
+            {return new_group_sis(network, scale_recovery,
+                    ThresholdRate(scale_infection, threshold),
+                    rate_bounds);}), R"pbdoc(
+            Constructor of the class ThresholdGroupSIS from a shared
+            network, with infection rate scale_infection*(n-i) in a group of
+            size n with at least threshold infected, and 0 otherwise.
+
+            Args:
+               network: BipartiteNetwork for the network structure.
+               scale_recovery: Recovery rate for infected nodes
+               scale_infection: Infection rate factor.
+               threshold: Minimal number of infected in a group.
+               rate_bounds: Initial guess of the rate lower and upper
+                            bounds, extended if needed; computed exactly
+                            from the rates if None.
+            )pbdoc", py::arg("network").none(false),
+                py::arg("scale_recovery"),
+                py::arg("scale_infection"),
+                py::arg("threshold"),
+                py::arg("rate_bounds")=py::none())
+
+        .def("get_lifetime", &ThresholdGroupSIS::get_lifetime, R"pbdoc(
+            Returns the lifetime for the current state.
+            )pbdoc");
+
+    m.def("specialized_powerlaw_group_sis", [](const py::array& edge_array,
+                double scale_recovery, double scale_infection,
+                double shape_infection, const RateBounds& rate_bounds)
+            {return make_powerlaw_group_sis(make_network(edge_array),
+                    scale_recovery, scale_infection, shape_infection,
+                    rate_bounds);}, R"pbdoc(
+            Returns the fastest SIS process with infection rate
+            scale_infection*(n-i)*i^shape_infection, from an edge array. The
+            shapes 1 and 2 give a LinearGroupSIS and a QuadraticGroupSIS,
+            other shapes a PowerlawGroupSIS.
+
+            Args:
+               edge_list: Array of shape (E,2) of (node,group) edges.
+               scale_recovery: Recovery rate for infected nodes
+               scale_infection: Infection rate factor.
                shape_infection: Power-law exponent for infection.
-               rate_bounds: Rate lower and upper bounds.
+               rate_bounds: Initial guess of the rate lower and upper
+                            bounds, extended if needed; computed exactly
+                            from the rates if None.
             )pbdoc", py::arg("edge_list"),
                 py::arg("scale_recovery"),
                 py::arg("scale_infection"),
                 py::arg("shape_infection"),
-                py::arg("rate_bounds"));
+                py::arg("rate_bounds")=py::none());
+
+    m.def("specialized_powerlaw_group_sis", [](const EdgeList& edge_list,
+                double scale_recovery, double scale_infection,
+                double shape_infection, const RateBounds& rate_bounds)
+            {return make_powerlaw_group_sis(
+                    make_shared<const BipartiteNetwork>(edge_list),
+                    scale_recovery, scale_infection, shape_infection,
+                    rate_bounds);}, R"pbdoc(
+            Returns the fastest SIS process with infection rate
+            scale_infection*(n-i)*i^shape_infection. The shapes 1 and 2 give
+            a LinearGroupSIS and a QuadraticGroupSIS, other shapes a
+            PowerlawGroupSIS.
+
+            Args:
+               edge_list: Edge list for the network structure.
+               scale_recovery: Recovery rate for infected nodes
+               scale_infection: Infection rate factor.
+               shape_infection: Power-law exponent for infection.
+               rate_bounds: Initial guess of the rate lower and upper
+                            bounds, extended if needed; computed exactly
+                            from the rates if None.
+            )pbdoc", py::arg("edge_list"),
+                py::arg("scale_recovery"),
+                py::arg("scale_infection"),
+                py::arg("shape_infection"),
+                py::arg("rate_bounds")=py::none());
+
+    m.def("specialized_powerlaw_group_sis",
+            [](shared_ptr<BipartiteNetwork> network,
+                double scale_recovery, double scale_infection,
+                double shape_infection, const RateBounds& rate_bounds)
+            {return make_powerlaw_group_sis(network, scale_recovery,
+                    scale_infection, shape_infection, rate_bounds);}, R"pbdoc(
+            Returns the fastest SIS process with infection rate
+            scale_infection*(n-i)*i^shape_infection, from a shared network.
+            The shapes 1 and 2 give a LinearGroupSIS and a QuadraticGroupSIS,
+            other shapes a PowerlawGroupSIS.
+
+            Args:
+               network: BipartiteNetwork for the network structure.
+               scale_recovery: Recovery rate for infected nodes
+               scale_infection: Infection rate factor.
+               shape_infection: Power-law exponent for infection.
+               rate_bounds: Initial guess of the rate lower and upper
+                            bounds, extended if needed; computed exactly
+                            from the rates if None.
+            )pbdoc", py::arg("network").none(false),
+                py::arg("scale_recovery"),
+                py::arg("scale_infection"),
+                py::arg("shape_infection"),
+                py::arg("rate_bounds")=py::none());
 
     py::class_<DiscreteSIS, BaseContagion>(m, "DiscreteSIS")
 
+        .def(py::init([](const py::array& edge_array,
+                        double recovery_probability,
+                        const vector<vector<double>>& infection_probability)
+            {return new DiscreteSIS(make_network(edge_array),
+                    recovery_probability, infection_probability);}), R"pbdoc(
+            Constructor of the class DiscreteSIS from an edge array.
+
+            Args:
+               edge_list: Array of shape (E,2) of (node,group) edges.
+               recovery_probability: Double for the recovery probability
+               infection_probability: vector of vector for the infection
+                                      probability for different group size
+                                      and number of infected
+            )pbdoc", py::arg("edge_list"),
+                py::arg("recovery_probability"),
+                py::arg("infection_probability"))
+
         .def(py::init<EdgeList, double,
                 std::vector<std::vector<double>>>(), R"pbdoc(
             Default constructor of the class GroupSIS.
@@ -261,6 +1090,23 @@ PYBIND11_MODULE(_schon, m)
                 py::arg("recovery_probability"),
                 py::arg("infection_probability"))
 
+        .def(py::init([](shared_ptr<BipartiteNetwork> network,
+                        double recovery_probability,
+                        const vector<vector<double>>& infection_probability)
+            {return new DiscreteSIS(network, recovery_probability,
+                    infection_probability);}), R"pbdoc(
+            Constructor of the class DiscreteSIS from a shared network.
+
+            Args:
+               network: BipartiteNetwork for the network structure.
+               recovery_probability: Double for the recovery probability
+               infection_probability: vector of vector for the infection
+                                      probability for different group size
+                                      and number of infected
+            )pbdoc", py::arg("network").none(false),
+                py::arg("recovery_probability"),
+                py::arg("infection_probability"))
+
         .def("get_lifetime", &DiscreteSIS::get_lifetime, R"pbdoc(
             Returns the lifetime for the current state.
             )pbdoc");
@@ -268,6 +1114,28 @@ PYBIND11_MODULE(_schon, m)
 
     py::class_<HeterogeneousExposure, BaseContagion>(m, "HeterogeneousExposure")
 
+        .def(py::init([](const py::array& edge_array,
+                        double recovery_probability, double alpha, double T,
+                        double beta, double K)
+            {return new HeterogeneousExposure(make_network(edge_array),
+                    recovery_probability, alpha, T, beta, K);}), R"pbdoc(
+            Constructor of the class HeterogeneousExposure from an edge
+            array.
+
+            Args:
+               edge_list: Array of shape (E,2) of (node,group) edges.
+               recovery_probability: Double for the recovery probability
+               alpha:  Double for the exponent of the participation time distribution
+               T: Double for the temporal window
+               beta: Double for the rate of dose accumulation
+               K: Double for the dose threshold
+            )pbdoc", py::arg("edge_list"),
+                py::arg("recovery_probability"),
+                py::arg("alpha"),
+                py::arg("T"),
+                py::arg("beta"),
+                py::arg("K"))
+
         .def(py::init<EdgeList, double, double, double,
                 double, double>(), R"pbdoc(
             Default constructor of the class GroupSIS.
@@ -286,11 +1154,113 @@ PYBIND11_MODULE(_schon, m)
                 py::arg("beta"),
                 py::arg("K"))
 
+        .def(py::init([](shared_ptr<BipartiteNetwork> network,
+                        double recovery_probability, double alpha, double T,
+                        double beta, double K)
+            {return new HeterogeneousExposure(network, recovery_probability,
+                    alpha, T, beta, K);}), R"pbdoc(
+            Constructor of the class HeterogeneousExposure from a shared
+            network.
+
+            Args:
+               network: BipartiteNetwork for the network structure.
+               recovery_probability: Double for the recovery probability
+               alpha:  Double for the exponent of the participation time distribution
+               T: Double for the temporal window
+               beta: Double for the rate of dose accumulation
+               K: Double for the dose threshold
+            )pbdoc", py::arg("network").none(false),
+                py::arg("recovery_probability"),
+                py::arg("alpha"),
+                py::arg("T"),
+                py::arg("beta"),
+                py::arg("K"))
+
         .def("get_lifetime", &HeterogeneousExposure::get_lifetime, R"pbdoc(
             Returns the lifetime for the current state.
             )pbdoc");
 
 
+    /* ==============
+     * Ensemble class
+     * ==============*/
+
+    py::class_<Ensemble>(m, "Ensemble")
+
+        .def(py::init([](const py::function& factory,
+                        size_t number_of_replicas, size_t number_of_threads)
+            {
+                //the factory is called from worker threads, the python
+                //objects it returns are kept alive by the process pointers;
+                //the processes in use, only accessed with the GIL, must not
+                //be returned again, as two threads would evolve them
+                auto in_use = make_shared<unordered_set<BaseContagion*>>();
+                ProcessFactory process_factory =
+                    [factory, in_use](size_t replica)
+                {
+                    py::gil_scoped_acquire acquire;
+                    py::object process = factory(replica);
+                    if (not py::isinstance<BaseContagion>(process))
+                    {
+                        throw py::type_error(
+                                "the factory must return a process");
+                    }
+                    BaseContagion* ptr = process.cast<BaseContagion*>();
+                    if (not in_use->insert(ptr).second)
+                    {
+                        throw py::value_error(
+                                "the factory must return a new process");
+                    }
+                    return shared_ptr<BaseContagion>(ptr,
+                        [process, in_use](BaseContagion* pointer) mutable
+                        {
+                            py::gil_scoped_acquire acquire;
+                            in_use->erase(pointer);
+                            process = py::object();
+                        });
+                };
+                return new Ensemble(process_factory, number_of_replicas,
+                        number_of_threads);
+            }), R"pbdoc(
+            Default constructor of the class Ensemble.
+
+            Args:
+               factory: Function returning a new ready to evolve process
+                        (seeded, initialized and with its measures) for a
+                        replica index. Replicas calling a Python infection
+                        rate on each event take turns holding the GIL.
+               number_of_replicas: Number of independent realizations.
+               number_of_threads: Number of threads, 0 to use all the
+                                  hardware threads.
+            )pbdoc", py::arg("factory"),
+                py::arg("number_of_replicas"),
+                py::arg("number_of_threads")=0)
+
+        .def("run", &Ensemble::run, py::call_guard<py::gil_scoped_release>(),
+                R"pbdoc(
+            Evolve all replicas in parallel, then merge their measures.
+
+            Args:
+               burn_in: Time period of the evolution without measure.
+               period: Time period of the evolution with measures.
+               decorrelation_time (optional): Time period for decorrelation.
+               quasistationary: Bool, if true quasistationary state.
+            )pbdoc", py::arg("burn_in"), py::arg("period"),
+                py::arg("decorrelation_time")=1,
+                py::arg("quasistationary")=false)
+
+        .def("get_measure_vector", &Ensemble::get_measure_vector, R"pbdoc(
+            Returns a vector of pointer to the measures merged over replicas.
+            )pbdoc")
+
+        .def("number_of_replicas", &Ensemble::number_of_replicas, R"pbdoc(
+            Returns the number of replicas.
+            )pbdoc")
+
+        .def("number_of_threads", &Ensemble::number_of_threads, R"pbdoc(
+            Returns the number of threads.
+            )pbdoc");
+
 
     /* ================
      * Measure classes
@@ -311,8 +1281,11 @@ PYBIND11_MODULE(_schon, m)
             Returns the name of the measure.
             )pbdoc")
 
-        .def("get_result", &MarginalInfectionProbability::get_result, R"pbdoc(
-            Returns the result associated to the measure.
+        .def("get_result", [](const MarginalInfectionProbability& measure)
+            {py::array_t<double> result(measure.size());
+                measure.get_result(result.mutable_data());
+                return result;}, R"pbdoc(
+            Returns the result associated to the measure, as an array.
             )pbdoc");
 
     py::class_<Prevalence,shared_ptr<Prevalence>>(m,
@@ -329,9 +1302,24 @@ PYBIND11_MODULE(_schon, m)
             Returns the name of the measure.
             )pbdoc")
 
-        .def("get_result", &Prevalence::get_result, R"pbdoc(
-            Returns the result associated to the measure.
-            )pbdoc");
+        .def("get_result", [](const Prevalence& measure)
+            {return shared_array(measure.get_shared_result());}, R"pbdoc(
+            Returns the result associated to the measure, as a read-only
+            NumPy array sharing the memory of the measure. The array is left
+            untouched by later measures, which are not copied into it.
+            )pbdoc")
+
+        .def("get_result_since", [](const Prevalence& measure, size_t offset)
+            {return shared_array(measure.get_shared_result(), offset);},
+            R"pbdoc(
+            Returns the result associated to the measure from an index, to
+            fetch new results incrementally, as a read-only NumPy array
+            sharing the memory of the measure.
+
+            Args:
+               offset: Index of the first result, e.g. the length of the
+                       result previously fetched.
+            )pbdoc", py::arg("offset"));
 
     py::class_<InfectiousSet,shared_ptr<InfectiousSet>>(m,
                 "InfectiousSet")
@@ -361,8 +1349,23 @@ PYBIND11_MODULE(_schon, m)
             Returns the name of the measure.
             )pbdoc")
 
-        .def("get_result", &Time::get_result, R"pbdoc(
-            Returns the result associated to the measure.
-            )pbdoc");
+        .def("get_result", [](const Time& measure)
+            {return shared_array(measure.get_shared_result());}, R"pbdoc(
+            Returns the result associated to the measure, as a read-only
+            NumPy array sharing the memory of the measure. The array is left
+            untouched by later measures, which are not copied into it.
+            )pbdoc")
+
+        .def("get_result_since", [](const Time& measure, size_t offset)
+            {return shared_array(measure.get_shared_result(), offset);},
+            R"pbdoc(
+            Returns the result associated to the measure from an index, to
+            fetch new results incrementally, as a read-only NumPy array
+            sharing the memory of the measure.
+
+            Args:
+               offset: Index of the first result, e.g. the length of the
+                       result previously fetched.
+            )pbdoc", py::arg("offset"));
 
 }
@@ -0,0 +1,2 @@
+#!/bin/bash
+g++ -std=c++17 -O3 -o bench_contagion _bench_contagion.cpp BaseContagion.cpp BipartiteNetwork.cpp ConfigurationHistory.cpp ContinuousSIS.cpp DiscreteSIS.cpp GroupSIS.cpp Prevalence.cpp MarginalInfectionProbability.cpp InfectiousSet.cpp Time.cpp SamplableSet/*.cpp -I.
@@ -0,0 +1,2 @@
+#!/bin/bash
+g++ -std=c++17 -O2 -o test_configuration _test_configuration.cpp BaseContagion.cpp BipartiteNetwork.cpp ConfigurationHistory.cpp ContinuousSIS.cpp ContinuousSIR.cpp Prevalence.cpp MarginalInfectionProbability.cpp InfectiousSet.cpp Time.cpp SamplableSet/*.cpp -I.
@@ -0,0 +1,2 @@
+#!/bin/bash
+g++ -std=c++17 -O2 -pthread -o test_ensemble _test_ensemble.cpp Ensemble.cpp BaseContagion.cpp BipartiteNetwork.cpp ConfigurationHistory.cpp ContinuousSIS.cpp Prevalence.cpp MarginalInfectionProbability.cpp InfectiousSet.cpp Time.cpp SamplableSet/*.cpp -I.
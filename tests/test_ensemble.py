@@ -0,0 +1,102 @@
+import threading
+
+import numpy as np
+import pytest
+
+_schon = pytest.importorskip("_schon")
+from _schon import BipartiteNetwork, Ensemble, GroupSIS, LinearGroupSIS
+
+#each node belongs to the groups 0 and 1 + node//4
+N = 40
+EDGE_LIST = [(node, 0) for node in range(N)] \
+        + [(node, 1 + node//4) for node in range(N)]
+NETWORK = BipartiteNetwork(EDGE_LIST)
+
+
+def linear_factory(replica):
+    process = LinearGroupSIS(NETWORK, 1., 0.1)
+    process.seed(42, replica)
+    process.infect_fraction(0.5)
+    process.measure_prevalence()
+    process.measure_time()
+    return process
+
+
+def python_rate_factory(replica):
+    process = GroupSIS(NETWORK, 1., lambda n, i: 0.1*(n - i)*i)
+    process.seed(42, replica)
+    process.infect_fraction(0.5)
+    process.measure_prevalence()
+    return process
+
+
+def measure_count(factory, number_of_replicas):
+    count = 0
+    for replica in range(number_of_replicas):
+        process = factory(replica)
+        process.evolve(1., 0.1)
+        process.evolve(2., 0.1, measure=True)
+        count += len(process.get_measure_vector()[0].get_result())
+    return count
+
+
+@pytest.mark.parametrize("number_of_threads", [1, 4])
+def test_run_merges_the_replicas(number_of_threads):
+    ensemble = Ensemble(linear_factory, 8, number_of_threads)
+    assert ensemble.number_of_replicas() == 8
+    assert ensemble.number_of_threads() == number_of_threads
+    ensemble.run(1., 2., 0.1)
+    prevalence, time = ensemble.get_measure_vector()
+    assert len(prevalence.get_result()) == measure_count(linear_factory, 8)
+    assert len(time.get_result()) == len(prevalence.get_result())
+    assert np.all((0 <= prevalence.get_result())
+            & (prevalence.get_result() <= 1))
+
+
+def test_run_is_independent_of_the_threads():
+    results = []
+    for number_of_threads in [1, 3]:
+        ensemble = Ensemble(linear_factory, 6, number_of_threads)
+        ensemble.run(1., 2., 0.1)
+        results.append(ensemble.get_measure_vector()[0].get_result())
+    assert np.array_equal(results[0], results[1])
+
+
+def test_run_with_python_rate():
+    #the replicas call the rate with the GIL, one at a time
+    ensemble = Ensemble(python_rate_factory, 4, 4)
+    ensemble.run(1., 2., 0.1)
+    result = ensemble.get_measure_vector()[0].get_result()
+    assert len(result) == measure_count(python_rate_factory, 4)
+
+
+def test_factory_errors():
+    def failing_factory(replica):
+        raise KeyError(replica)
+    with pytest.raises(KeyError):
+        Ensemble(failing_factory, 4, 2).run(1., 2.)
+    with pytest.raises(TypeError):
+        Ensemble(lambda replica: None, 4, 2).run(1., 2.)
+    with pytest.raises(TypeError):
+        Ensemble(lambda replica: 1, 4, 2).run(1., 2.)
+    #both replicas are built before either is evolved
+    process = linear_factory(0)
+    barrier = threading.Barrier(2, timeout=10)
+    def same_process_factory(replica):
+        barrier.wait()
+        return process
+    with pytest.raises(ValueError):
+        Ensemble(same_process_factory, 2, 2).run(1., 2.)
+
+
+def test_processes_outlive_the_factory():
+    processes = []
+    def factory(replica):
+        process = linear_factory(replica)
+        processes.append(process)
+        return process
+    ensemble = Ensemble(factory, 4, 2)
+    del factory
+    ensemble.run(1., 2., 0.1)
+    assert len(processes) == 4
+    assert all(process.get_current_time() > 0 for process in processes)
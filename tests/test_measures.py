@@ -0,0 +1,71 @@
+import numpy as np
+import pytest
+
+_schon = pytest.importorskip("_schon")
+from _schon import ContinuousSIS
+
+#each node belongs to the groups 0 and 1 + node//2
+N = 100
+EDGE_LIST = [(node, 0) for node in range(N)] \
+        + [(node, 1 + node//2) for node in range(N)]
+
+
+@pytest.fixture
+def process():
+    infection_rate = [[0.1*i for i in range(n+1)] for n in range(N+1)]
+    group_transmission_rate = [1.]*(1 + N//2)
+    process = ContinuousSIS(EDGE_LIST, 1., infection_rate,
+            group_transmission_rate)
+    process.seed(42)
+    process.infect_fraction(0.5)
+    process.measure_prevalence()
+    process.measure_time()
+    return process
+
+
+def test_get_result_is_read_only_array(process):
+    process.evolve(1., 0.1)
+    for measure in process.get_measure_vector():
+        result = measure.get_result()
+        assert isinstance(result, np.ndarray)
+        assert result.dtype == np.float64
+        assert not result.flags.writeable
+        with pytest.raises(ValueError):
+            result[0] = 1.
+
+
+def test_result_untouched_by_later_measures(process):
+    prevalence, time = process.get_measure_vector()
+    process.evolve(1., 0.1)
+    first_prevalence = prevalence.get_result()
+    first_time = time.get_result()
+    expected_prevalence = first_prevalence.copy()
+    expected_time = first_time.copy()
+    for _ in range(20):
+        process.evolve(1., 0.1)
+    assert np.array_equal(first_prevalence, expected_prevalence)
+    assert np.array_equal(first_time, expected_time)
+    assert np.array_equal(prevalence.get_result()[:len(expected_time)],
+            expected_prevalence)
+    assert len(time.get_result()) > len(expected_time)
+
+
+def test_result_outlives_measure(process):
+    process.evolve(1., 0.1)
+    result = process.get_measure_vector()[0].get_result()
+    expected = result.copy()
+    del process
+    assert np.array_equal(result, expected)
+
+
+def test_get_result_since_polling(process):
+    prevalence, time = process.get_measure_vector()
+    chunks = []
+    for _ in range(20):
+        process.evolve(1., 0.1)
+        chunk = time.get_result_since(sum(len(c) for c in chunks))
+        assert not chunk.flags.writeable
+        chunks.append(chunk)
+    assert np.array_equal(np.concatenate(chunks), time.get_result())
+    assert len(prevalence.get_result_since(len(prevalence.get_result()))) == 0
+    assert len(prevalence.get_result_since(10**6)) == 0
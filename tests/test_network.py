@@ -0,0 +1,85 @@
+import numpy as np
+import pytest
+
+_schon = pytest.importorskip("_schon")
+from _schon import BipartiteNetwork, ContinuousSIS
+
+#each node belongs to the groups 0 and 1 + node//2
+N = 10
+EDGE_LIST = [(node, 0) for node in range(N)] \
+        + [(node, 1 + node//2) for node in range(N)]
+
+
+def same_network(network, reference):
+    return network.number_of_nodes() == reference.number_of_nodes() \
+        and network.number_of_groups() == reference.number_of_groups() \
+        and all(sorted(network.group_members(group))
+                == sorted(reference.group_members(group))
+                for group in range(reference.number_of_groups()))
+
+
+@pytest.mark.parametrize("dtype",
+        [np.uint32, np.int32, np.int64, np.uint64, np.float64])
+def test_edge_array_dtypes(dtype):
+    reference = BipartiteNetwork(np.array(EDGE_LIST, dtype=np.uint32))
+    network = BipartiteNetwork(np.array(EDGE_LIST, dtype=dtype))
+    assert same_network(network, reference)
+
+
+@pytest.mark.parametrize("dtype", [np.int32, np.int64, np.float64])
+def test_node_and_group_arrays(dtype):
+    reference = BipartiteNetwork(EDGE_LIST)
+    nodes = np.array([edge[0] for edge in EDGE_LIST], dtype=dtype)
+    groups = np.array([edge[1] for edge in EDGE_LIST], dtype=dtype)
+    assert same_network(BipartiteNetwork(nodes, groups), reference)
+
+
+def test_edge_list():
+    network = BipartiteNetwork(EDGE_LIST)
+    assert network.number_of_nodes() == N
+    assert network.number_of_edges() == len(EDGE_LIST)
+    assert same_network(BipartiteNetwork([list(edge) for edge in EDGE_LIST]),
+            network)
+
+
+@pytest.mark.parametrize("edges", [
+    np.array([(0, 0), (-1, 0)], dtype=np.int64),
+    np.array([(0, 0), (1, -1)], dtype=np.int32),
+    np.array([(0, 0), (2**32, 0)], dtype=np.int64),
+    np.array([(0, 0), (2**40, 0)], dtype=np.uint64),
+    np.array([(0, 0), (1.5, 0)]),
+    np.array([(0, 0), (np.nan, 0)]),
+    np.array([(0, 0), (np.inf, 0)]),
+    ])
+def test_invalid_labels(edges):
+    with pytest.raises(ValueError):
+        BipartiteNetwork(edges)
+    with pytest.raises(ValueError):
+        BipartiteNetwork(edges[:,0], edges[:,1])
+
+
+def test_non_numeric_labels():
+    with pytest.raises(TypeError):
+        BipartiteNetwork(np.array([(True, False)]))
+
+
+def test_edge_shape():
+    with pytest.raises(ValueError):
+        BipartiteNetwork(np.zeros((3, 3), dtype=np.uint32))
+    with pytest.raises(ValueError):
+        BipartiteNetwork(np.zeros(3, dtype=np.uint32),
+                np.zeros(2, dtype=np.uint32))
+
+
+def test_process_from_edge_array():
+    #a process takes the array path for every dtype, and rejects the labels
+    #that would otherwise be wrapped
+    infection_rate = [[0.]*(n+1) for n in range(N+1)]
+    group_transmission_rate = [1.]*(1 + N//2)
+    for dtype in [np.uint32, np.int64, np.float64]:
+        process = ContinuousSIS(np.array(EDGE_LIST, dtype=dtype), 1.,
+                infection_rate, group_transmission_rate)
+        assert process.size() == N
+    with pytest.raises(ValueError):
+        ContinuousSIS(np.array(EDGE_LIST + [(-1, 0)]), 1.,
+                infection_rate, group_transmission_rate)
@@ -0,0 +1,203 @@
+import threading
+
+import numpy as np
+import pytest
+
+_schon = pytest.importorskip("_schon")
+from _schon import BipartiteNetwork, GroupSIS, PowerlawGroupSIS, \
+        LinearGroupSIS, QuadraticGroupSIS, ThresholdGroupSIS, \
+        ContinuousSIS, ContinuousSIR, DiscreteSIS, HeterogeneousExposure, \
+        MarginalInfectionProbability, specialized_powerlaw_group_sis
+
+#each node belongs to the groups 0 and 1 + node//4
+N = 40
+EDGE_LIST = [(node, 0) for node in range(N)] \
+        + [(node, 1 + node//4) for node in range(N)]
+EDGE_ARRAY = np.array(EDGE_LIST, dtype=np.int64)
+NUMBER_OF_GROUPS = 1 + N//4
+
+
+def powerlaw_rate(n, i):
+    return 0.1*(n - i)*i**1.5
+
+
+def group_processes(network):
+    return [GroupSIS(network, 1., powerlaw_rate),
+            GroupSIS(network, 1., powerlaw_rate, tabulate=True),
+            PowerlawGroupSIS(network, 1., 0.1, 1.5),
+            LinearGroupSIS(network, 1., 0.1),
+            QuadraticGroupSIS(network, 1., 0.1),
+            ThresholdGroupSIS(network, 1., 0.1, 2)]
+
+
+def other_processes(network):
+    infection_rate = [[0.1*i for i in range(n+1)] for n in range(N+1)]
+    group_transmission_rate = [1.]*NUMBER_OF_GROUPS
+    infection_probability = [[1 - np.exp(-0.25*i) for i in range(n+1)]
+            for n in range(N+1)]
+    return [ContinuousSIS(network, 1., infection_rate,
+                group_transmission_rate),
+            ContinuousSIR(network, 1., infection_rate,
+                group_transmission_rate),
+            DiscreteSIS(network, 0.5, infection_probability),
+            HeterogeneousExposure(network, 0.3, 1.5, 10., 1., 0.5)]
+
+
+def run(process, seed=42):
+    process.seed(seed)
+    process.infect_fraction(0.5)
+    process.evolve(2., 0.5)
+    return process.get_number_of_infected_nodes()
+
+
+@pytest.mark.parametrize("source", [EDGE_LIST, EDGE_ARRAY])
+def test_processes_share_a_network(source):
+    network = BipartiteNetwork(source)
+    for process in group_processes(network) + other_processes(network):
+        assert process.get_network() is network
+        assert process.size() == N
+        assert 0 <= run(process) <= N
+        assert process.get_current_time() > 0
+
+
+def test_edge_list_and_array_constructors():
+    for source in [EDGE_LIST, EDGE_ARRAY]:
+        for process in [GroupSIS(source, 1., powerlaw_rate),
+                PowerlawGroupSIS(source, 1., 0.1, 1.5),
+                LinearGroupSIS(source, 1., 0.1),
+                QuadraticGroupSIS(source, 1., 0.1),
+                ThresholdGroupSIS(source, 1., 0.1, 2)]:
+            assert process.get_network().number_of_nodes() == N
+            assert 0 <= run(process) <= N
+
+
+def test_rate_bounds():
+    network = BipartiteNetwork(EDGE_LIST)
+    #an initial guess of the bounds, too narrow or not, leaves the
+    #process unchanged up to the sampling
+    for rate_bounds in [None, (0.1, 10.), [1., 1.]]:
+        for process in [GroupSIS(network, 1., powerlaw_rate,
+                    rate_bounds=rate_bounds),
+                LinearGroupSIS(network, 1., 0.1, rate_bounds=rate_bounds),
+                PowerlawGroupSIS(network, 1., 0.1, 1.5,
+                    rate_bounds=rate_bounds)]:
+            assert 0 <= run(process) <= N
+    with pytest.raises(TypeError):
+        LinearGroupSIS(network, 1., 0.1, rate_bounds=1.)
+
+
+def test_tabulate():
+    network = BipartiteNetwork(EDGE_LIST)
+    calls = []
+    def rate(n, i):
+        calls.append((n, i))
+        return powerlaw_rate(n, i)
+    process = GroupSIS(network, 1., rate, tabulate=True)
+    assert process.is_tabulated()
+    assert process.rate_table_footprint() > 0
+    #the table holds the group sizes present, 4 and N
+    assert len(calls) == (4 + 1) + (N + 1)
+    run(process)
+    assert len(calls) == (4 + 1) + (N + 1)
+    process = GroupSIS(network, 1., rate)
+    assert not process.is_tabulated()
+    assert process.rate_table_footprint() == 0
+    calls.clear()
+    run(process)
+    assert len(calls) > 0
+
+
+def test_python_rate_with_threads():
+    #the untabulated process keeps the GIL, while the others release it
+    network = BipartiteNetwork(EDGE_LIST)
+    stop = threading.Event()
+    def spin():
+        while not stop.is_set():
+            sum(range(100))
+    thread = threading.Thread(target=spin)
+    thread.start()
+    try:
+        for process in group_processes(network):
+            assert 0 <= run(process) <= N
+    finally:
+        stop.set()
+        thread.join()
+
+
+def test_python_rate_exception():
+    def rate(n, i):
+        if i > 0:
+            raise ValueError("rate")
+        return 0.
+    network = BipartiteNetwork(EDGE_LIST)
+    process = GroupSIS(network, 1., rate, rate_bounds=(0.1, 1.))
+    with pytest.raises(ValueError):
+        run(process)
+
+
+def test_powerlaw_integer_shapes_match_inline_kernels():
+    network = BipartiteNetwork(EDGE_LIST)
+    for shape, specialized in [(1., LinearGroupSIS),
+            (2., QuadraticGroupSIS)]:
+        reference = specialized(network, 1., 0.1)
+        process = PowerlawGroupSIS(network, 1., 0.1, shape)
+        assert not process.is_tabulated()
+        assert process.rate_table_footprint() == 0
+        for infected in [reference, process]:
+            infected.load_configuration(list(range(0, N, 3)))
+        assert process.get_lifetime() \
+                == pytest.approx(reference.get_lifetime())
+    assert PowerlawGroupSIS(network, 1., 0.1, 1.5).is_tabulated()
+
+
+@pytest.mark.parametrize("source",
+        [EDGE_LIST, EDGE_ARRAY, BipartiteNetwork(EDGE_LIST)])
+def test_specialized_powerlaw_group_sis(source):
+    assert type(specialized_powerlaw_group_sis(source, 1., 0.1, 1.)) \
+            is LinearGroupSIS
+    assert type(specialized_powerlaw_group_sis(source, 1., 0.1, 2.)) \
+            is QuadraticGroupSIS
+    process = specialized_powerlaw_group_sis(source, 1., 0.1, 1.5,
+            rate_bounds=(0.1, 1.))
+    assert type(process) is PowerlawGroupSIS
+    assert 0 <= run(process) <= N
+
+
+def test_load_configuration():
+    network = BipartiteNetwork(EDGE_LIST)
+    for process in group_processes(network) + other_processes(network)[:1]:
+        process.load_configuration([0, 1, 2, 2])
+        assert process.get_number_of_infected_nodes() == 3
+        process.load_configuration([])
+        assert process.get_number_of_infected_nodes() == 0
+        with pytest.raises(IndexError):
+            process.load_configuration([N])
+
+
+def test_seed_stream():
+    network = BipartiteNetwork(EDGE_LIST)
+    def sample(seed, stream):
+        process = LinearGroupSIS(network, 1., 0.1)
+        process.seed(seed, stream)
+        process.measure_time()
+        process.infect_fraction(0.5)
+        process.evolve(5., 0.1, measure=True)
+        return process.get_measure_vector()[0].get_result()
+    assert np.array_equal(sample(1, 0), sample(1, 0))
+    assert not np.array_equal(sample(1, 0), sample(1, 1))
+
+
+def test_marginal_infection_probability_array():
+    network = BipartiteNetwork(EDGE_LIST)
+    process = LinearGroupSIS(network, 1., 0.1)
+    process.seed(42)
+    process.measure_marginal_infection_probability()
+    process.infect_fraction(0.5)
+    process.evolve(5., 0.1, measure=True)
+    result = process.get_measure_vector()[0].get_result()
+    assert isinstance(result, np.ndarray)
+    assert result.shape == (N,)
+    assert np.all((0 <= result) & (result <= 1))
+    #the array owns its memory
+    del process
+    assert np.all((0 <= result) & (result <= 1))